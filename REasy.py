@@ -37,6 +37,12 @@ def _show_zip_error() -> None:
 
 
 def main():
+    # Batch jobs never touch Qt, so they skip the GUI bootstrap entirely.
+    if len(sys.argv) > 1 and sys.argv[1] == "--batch":
+        from headless import main as run_batch
+
+        return run_batch(sys.argv[2:])
+
     if _launched_from_temp():
         _show_zip_error()
         return 1
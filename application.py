@@ -1,6 +1,7 @@
 """Application bootstrap for native dependencies, Qt, and translations."""
 
 import gc
+import importlib.machinery
 import os
 from pathlib import Path
 import subprocess
@@ -47,9 +48,19 @@ def _compile_translation_if_needed(settings: dict) -> None:
         subprocess.check_call([compiler, str(source), "-qm", str(compiled)])
 
 
+def _require_extension(module) -> None:
+    origin = getattr(module, "__file__", "") or ""
+    if not origin.endswith(tuple(importlib.machinery.EXTENSION_SUFFIXES)):
+        raise ImportError(f"{module.__name__} is not a compiled extension ({origin or 'built-in'})")
+
+
 def _prepare_native_modules() -> None:
     ensure_fast_pakresolve()
     ensure_fastmesh()
+    # fast_string_scan is built alongside the others; refuse to run on a stale or shadowing copy.
+    import fast_string_scan
+
+    _require_extension(fast_string_scan)
 
 
 def main(argv=None) -> int:
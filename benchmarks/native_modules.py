@@ -0,0 +1,542 @@
+#!/usr/bin/env python3
+"""Parity and throughput checks for the native extension modules.
+
+Each case runs the compiled module against a pure-Python reference on the same
+input, fails on any output difference, and reports throughput, p50/p99 latency
+and the process peak RSS after the case. Real RE Engine samples can be passed
+in; otherwise deterministic synthetic data is generated at the sizes of --scale
+(quick: one small size per case; full: 10k/1M/5M paths, 100 MB/1 GB binaries and
+100k/1M/5M vertices).
+
+    python benchmarks/native_modules.py --paths natives_list.txt --pak re_chunk_000.pak --binary game.exe
+    python benchmarks/native_modules.py --scale full --json bench.json --baseline last.json --max-regression 0.2
+
+The exit status is non-zero when a module is missing, is not a compiled
+extension (a silent fallback), disagrees with its reference, or runs slower
+than --max-regression allows against the --baseline JSON.
+"""
+
+from __future__ import annotations
+
+import argparse
+import array
+import importlib
+import importlib.machinery
+import json
+import math
+import os
+import platform
+import random
+import struct
+import sys
+import time
+from pathlib import Path
+
+MODULES = ("fast_pakresolve", "fast_string_scan", "fastmesh")
+
+# Sizes per --scale: path counts, binary sizes in MB, vertex counts.
+SCALES = {
+    "quick": {"paths": (200_000,), "binary_mb": (16,), "vertices": (500_000,)},
+    "full": {"paths": (10_000, 1_000_000, 5_000_000), "binary_mb": (100, 1024), "vertices": (100_000, 1_000_000, 5_000_000)},
+}
+
+
+def _load_native(name: str):
+    try:
+        module = importlib.import_module(name)
+    except ImportError as exc:
+        return None, f"not importable ({exc})"
+    origin = getattr(module, "__file__", "") or ""
+    if not origin.endswith(tuple(importlib.machinery.EXTENSION_SUFFIXES)):
+        return None, f"not a compiled extension ({origin or 'built-in'})"
+    return module, origin
+
+
+class Timing:
+    """Wall-clock samples of one case; throughput is derived from the median."""
+
+    def __init__(self, samples: list[float]) -> None:
+        self.samples = sorted(max(s, 1e-9) for s in samples)
+
+    def percentile(self, pct: float) -> float:
+        # nearest-rank, so p99 of a handful of runs is the slowest run
+        rank = max(1, math.ceil(pct / 100 * len(self.samples)))
+        return self.samples[rank - 1]
+
+    @property
+    def p50(self) -> float:
+        return self.percentile(50)
+
+    @property
+    def p99(self) -> float:
+        return self.percentile(99)
+
+
+def _timed(fn, repeat: int):
+    samples = []
+    result = None
+    for _ in range(max(1, repeat)):
+        start = time.perf_counter()
+        result = fn()
+        samples.append(time.perf_counter() - start)
+    return result, Timing(samples)
+
+
+def peak_rss_mb() -> float | None:
+    """High-water resident set size of this process, or None where unavailable."""
+    try:
+        import resource
+    except ImportError:
+        return None
+    peak = resource.getrusage(resource.RUSAGE_SELF).ru_maxrss
+    return peak / (1 << 20) if sys.platform == "darwin" else peak / 1024
+
+
+def size_label(value: int, unit: str = "") -> str:
+    for scale, suffix in ((1 << 30, "G"), (1 << 20, "M"), (1 << 10, "k")) if unit else ((10**9, "G"), (10**6, "M"), (10**3, "k")):
+        if value >= scale and value % scale == 0:
+            return f"{value // scale}{suffix}{unit}"
+    return f"{value}{unit}"
+
+
+class Report:
+    def __init__(self, baseline: dict | None = None, max_regression: float | None = None) -> None:
+        self.failures: list[str] = []
+        self.cases: list[dict] = []
+        self.baseline = {case["case"]: case for case in (baseline or {}).get("cases", [])}
+        self.max_regression = max_regression
+        print(
+            f"{'case':<42}{'native MB/s':>12}{'items/s':>16}{'p50 ms':>10}{'p99 ms':>10}"
+            f"{'ref MB/s':>11}{'speedup':>9}{'RSS MB':>9}  parity"
+        )
+
+    def row(self, case: str, size: int, items: int, native: Timing, ref_s: float, ok: bool) -> None:
+        ref_s = max(ref_s, 1e-9)
+        rss = peak_rss_mb()
+        record = {
+            "case": case,
+            "bytes": size,
+            "items": items,
+            "p50_s": native.p50,
+            "p99_s": native.p99,
+            "runs": len(native.samples),
+            "mb_per_s": size / native.p50 / 1e6,
+            "items_per_s": items / native.p50,
+            "reference_mb_per_s": size / ref_s / 1e6,
+            "speedup": ref_s / native.p50,
+            "peak_rss_mb": rss,
+            "parity": ok,
+        }
+        line = (
+            f"{case:<42}{record['mb_per_s']:>12.1f}{record['items_per_s']:>16,.0f}"
+            f"{native.p50 * 1e3:>10.2f}{native.p99 * 1e3:>10.2f}{record['reference_mb_per_s']:>11.2f}"
+            f"{record['speedup']:>8.1f}x{rss if rss is not None else float('nan'):>9.0f}  {'ok' if ok else 'MISMATCH'}"
+        )
+        previous = self.baseline.get(case)
+        if previous and previous.get("p50_s"):
+            record["baseline_p50_s"] = previous["p50_s"]
+            change = native.p50 / previous["p50_s"] - 1.0
+            line += f"  {change:+.1%} vs baseline"
+            if self.max_regression is not None and change > self.max_regression:
+                line += " REGRESSION"
+                self.failures.append(case)
+        print(line)
+        self.cases.append(record)
+        if not ok:
+            self.failures.append(case)
+
+    def fail(self, case: str, reason: str) -> None:
+        print(f"{case:<42}{reason}")
+        self.failures.append(case)
+
+
+# Pure-Python references --------------------------------------------------------------------------
+
+def murmur3_32(data: bytes, seed: int = 0xFFFFFFFF) -> int:
+    c1, c2, mask = 0xCC9E2D51, 0x1B873593, 0xFFFFFFFF
+    h = seed
+    rounded = len(data) & ~3
+    for (k,) in struct.iter_unpack("<I", data[:rounded]):
+        k = (k * c1) & mask
+        k = ((k << 15) | (k >> 17)) & mask
+        h ^= (k * c2) & mask
+        h = ((h << 13) | (h >> 19)) & mask
+        h = (h * 5 + 0xE6546B64) & mask
+    tail = data[rounded:]
+    if tail:
+        k = int.from_bytes(tail, "little")
+        k = (k * c1) & mask
+        k = ((k << 15) | (k >> 17)) & mask
+        h ^= (k * c2) & mask
+    h ^= len(data)
+    h ^= h >> 16
+    h = (h * 0x85EBCA6B) & mask
+    h ^= h >> 13
+    h = (h * 0xC2B2AE35) & mask
+    return h ^ (h >> 16)
+
+
+def path_hash(path: str, encoding: str = "utf-16le") -> int:
+    return (murmur3_32(path.upper().encode(encoding)) << 32) | murmur3_32(path.lower().encode(encoding))
+
+
+def reference_resolve(toc_hashes: list[int], paths: list[str], encoding: str = "utf-16le"):
+    index = {h: i for i, h in enumerate(toc_hashes)}
+    path_indices, toc_indices = [], []
+    for i, path in enumerate(paths):
+        hit = index.get(path_hash(path, encoding))
+        if hit is not None:
+            path_indices.append(i)
+            toc_indices.append(hit)
+    return path_indices, toc_indices
+
+
+def _printable(text: str) -> bool:
+    return text.isprintable()
+
+
+def reference_extract_strings(data: bytes, min_length: int) -> list[str]:
+    strings = []
+    length = len(data)
+    for parity in (0, 1):
+        i = parity
+        while i <= length - min_length * 2:
+            if not (32 <= data[i] <= 126 and data[i + 1] == 0):
+                i += 2
+                continue
+            j = i
+            while j <= length - 2:
+                unit = data[j] | (data[j + 1] << 8)
+                if unit == 0 or not chr(unit).isprintable():
+                    break
+                j += 2
+            if (j - i) // 2 >= min_length:
+                strings.append(data[i:j].decode("utf-16le"))
+                i = j + 2
+            else:
+                i += 2
+    utf8_min = max(min_length, 10)
+    i = 0
+    while i < length:
+        while i < length and not (0x20 <= data[i] <= 0x7E or data[i] >= 0x80):
+            i += 1
+        start = i
+        while i < length and (0x20 <= data[i] <= 0x7E or data[i] >= 0x80):
+            i += 1
+        if i - start < utf8_min:
+            continue
+        try:
+            text = data[start:i].decode("utf-8")
+        except UnicodeDecodeError:
+            continue
+        if _printable(text):
+            strings.append(text)
+    return strings
+
+
+def reference_unpack_normals_tangents(data: bytes):
+    normals, tangents = array.array("f"), array.array("f")
+    normal_ws, tangent_ws = array.array("B"), array.array("B")
+    for values in struct.iter_unpack("8b", data[: len(data) // 8 * 8]):
+        normals.extend(v / 127.0 for v in values[0:3])
+        normal_ws.append(values[3] & 0xFF)
+        tangents.extend(v / 127.0 for v in values[4:7])
+        tangent_ws.append(values[7] & 0xFF)
+    return normals, normal_ws, tangents, tangent_ws
+
+
+def reference_unpack_uvs(data: bytes):
+    return array.array("d", (1.0 - v for (v,) in struct.iter_unpack("<e", data[: len(data) // 4 * 4])))
+
+
+def reference_pack_uvs(uvs) -> bytes:
+    return b"".join(struct.pack("<e", 1.0 - v) for v in uvs)
+
+
+def reference_unpack_weights(data: bytes, bones: int):
+    ids, weights = array.array("B"), array.array("f")
+    for start in range(0, len(data) // (2 * bones) * 2 * bones, 2 * bones):
+        ids.extend(data[start:start + bones])
+        weights.extend(b / 255.0 for b in data[start + bones:start + 2 * bones])
+    return ids, weights
+
+
+def reference_pack_weights(ids, weights, bones: int) -> bytes:
+    out = bytearray()
+    for start in range(0, len(ids), bones):
+        out += bytes(ids[start:start + bones])
+        out += bytes(min(255, max(0, math.floor(w * 255.0 + 0.5))) for w in weights[start:start + bones])
+    return bytes(out)
+
+
+# Samples ---------------------------------------------------------------------------------------
+
+def synthetic_paths(count: int, rng: random.Random) -> list[str]:
+    folders = ("natives/stm/character", "natives/stm/environment/props", "natives/STM/UI/Menu", "natives/stm/sound/bank")
+    extensions = (".mesh.221108797", ".tex.241106027", ".mdf2.40", ".user.2", ".pfb.17", ".bnk.2.x64")
+    return [f"{rng.choice(folders)}/{rng.choice('abcdefgh')}{i:06d}{rng.choice(extensions)}" for i in range(count)]
+
+
+def synthetic_binary(size: int, paths: list[str], rng: random.Random) -> bytearray:
+    # UTF-16LE paths land on odd and even offsets alike, so both scan parities are exercised
+    out = bytearray()
+    while len(out) < size:
+        out += rng.randbytes(min(size - len(out), 1 << 26))
+    for path in paths[:max(2000, size >> 13)]:
+        encoded = path.encode("utf-16le" if rng.random() < 0.7 else "utf-8")
+        pos = rng.randrange(max(1, len(out) - len(encoded)))
+        out[pos:pos + len(encoded)] = encoded
+        out[pos + len(encoded):pos + len(encoded) + 2] = b"\0\0"
+    del out[size:]
+    return out
+
+
+def read_pak_hashes(path: Path) -> list[int] | None:
+    with path.open("rb") as fh:
+        header = fh.read(16)
+        if len(header) < 16 or header[:4] != b"KPKA":
+            return None
+        major, feature, count = header[4], int.from_bytes(header[6:8], "little"), int.from_bytes(header[8:12], "little")
+        if feature & 0x8 or major not in (2, 4):
+            return None
+        entry_size = 24 if major == 2 else 48
+        table = fh.read(count * entry_size)
+    hashes = []
+    for i in range(len(table) // entry_size):
+        entry = table[i * entry_size:(i + 1) * entry_size]
+        if major == 4:
+            lo, hi = struct.unpack_from("<II", entry, 0)
+        else:
+            lo, hi = struct.unpack_from("<II", entry, 16)
+        hashes.append((hi << 32) | lo)
+    return hashes
+
+
+# Cases -----------------------------------------------------------------------------------------
+
+def bench_murmur3(module, report: Report, paths: list[str], args) -> None:
+    encoded = [p.lower().encode("utf-16le") for p in paths[: args.reference_items]]
+    native, timing = _timed(lambda: [module.murmur3_hash(b) for b in encoded], args.repeat)
+    reference, ref = _timed(lambda: [murmur3_32(b) for b in encoded], 1)
+    report.row("fast_pakresolve.murmur3_hash", sum(map(len, encoded)), len(encoded), timing, ref.p50, native == reference)
+
+
+def bench_resolve(module, report: Report, paths: list[str], toc_hashes: dict[str, list[int]], args) -> None:
+    sample = paths[: args.reference_items]
+    for encoding, resolve in (("utf-16le", module.resolve_paths_utf16le), ("utf-8", module.resolve_paths_utf8)):
+        hashes = toc_hashes[encoding]
+        index = module.PakHashIndex(hashes)
+        (_, path_indices, toc_indices), timing = _timed(lambda: resolve(index, paths, threads=args.threads), args.repeat)
+        sample_hits = sum(1 for i in path_indices if i < len(sample))
+        ref, ref_timing = _timed(lambda: reference_resolve(hashes, sample, encoding), 1)
+        ok = list(path_indices)[:sample_hits] == ref[0] and list(toc_indices)[:sample_hits] == ref[1]
+        size = sum(len(p.encode(encoding)) for p in paths)
+        ref_s = ref_timing.p50 * len(paths) / max(1, len(sample))
+        report.row(f"fast_pakresolve.resolve_{encoding.replace('-', '')}[{size_label(len(paths))}]", size, len(paths), timing, ref_s, ok)
+
+
+def bench_string_scan(module, report: Report, binary, args) -> None:
+    sample = bytes(binary[: args.reference_bytes])
+    native, timing = _timed(lambda: module.extract_strings(binary, args.min_length, threads=args.threads), args.repeat)
+    reference, ref = _timed(lambda: reference_extract_strings(sample, args.min_length), 1)
+    ok = module.extract_strings(sample, args.min_length) == reference
+    ref_s = ref.p50 * len(binary) / max(1, len(sample))
+    report.row(f"fast_string_scan.extract_strings[{size_label(len(binary), 'B')}]", len(binary), len(native), timing, ref_s, ok)
+
+
+def _snorm8(value: float) -> int:
+    return max(-128, min(127, round(value * 127.0)))
+
+
+def reference_pack_normals_tangents(normals, normal_ws, tangents, tangent_ws) -> bytes:
+    out = bytearray()
+    for i in range(len(normal_ws)):
+        out += struct.pack("<3bB", *map(_snorm8, normals[i * 3:i * 3 + 3]), normal_ws[i])
+        out += struct.pack("<3bB", *map(_snorm8, tangents[i * 3:i * 3 + 3]), tangent_ws[i])
+    return bytes(out)
+
+
+def bench_fastmesh(module, report: Report, vertices: int, rng: random.Random, args) -> None:
+    """Every pack/unpack pair on random records; each pack must restore the original bytes."""
+    label = f"[{size_label(vertices)}]"
+    sample_vertices = min(vertices, args.reference_items)
+    scale = vertices / sample_vertices
+
+    packed = rng.randbytes(vertices * 8)
+    native, timing = _timed(lambda: module.unpack_normals_tangents(packed), args.repeat)
+    reference, ref = _timed(lambda: reference_unpack_normals_tangents(packed[: sample_vertices * 8]), 1)
+    sample = module.unpack_normals_tangents(packed[: sample_vertices * 8])
+    ok = all(a.tobytes() == b.tobytes() for a, b in zip(sample, reference))
+    report.row("fastmesh.unpack_normals_tangents" + label, len(packed), vertices, timing, ref.p50 * scale, ok)
+
+    repacked, timing = _timed(lambda: module.pack_normals_tangents(*native), args.repeat)
+    reference, ref = _timed(lambda: reference_pack_normals_tangents(*sample), 1)
+    ok = repacked == packed and reference == packed[: sample_vertices * 8]
+    report.row("fastmesh.pack_normals_tangents" + label, len(packed), vertices, timing, ref.p50 * scale, ok)
+
+    # a tile of random half-float pairs keeps generation cheap at millions of vertices
+    tile = min(vertices, 1 << 16)
+    uv_tile = b"".join(struct.pack("<e", rng.uniform(-1.0, 2.0)) for _ in range(tile * 2))
+    uv_bytes = (uv_tile * -(-vertices // tile))[: vertices * 4]
+    native, timing = _timed(lambda: module.unpack_uvs(uv_bytes), args.repeat)
+    reference, ref = _timed(lambda: reference_unpack_uvs(uv_bytes[: sample_vertices * 4]), 1)
+    ok = module.unpack_uvs(uv_bytes[: sample_vertices * 4]).tobytes() == reference.tobytes()
+    report.row("fastmesh.unpack_uvs" + label, len(uv_bytes), vertices, timing, ref.p50 * scale, ok)
+
+    repacked, timing = _timed(lambda: module.pack_uvs(native), args.repeat)
+    reference, ref = _timed(lambda: reference_pack_uvs(native[: sample_vertices * 2]), 1)
+    ok = repacked[: sample_vertices * 4] == reference and repacked == uv_bytes
+    report.row("fastmesh.pack_uvs" + label, len(native) * 8, vertices, timing, ref.p50 * scale, ok)
+
+    colors = rng.randbytes(vertices * 4)
+    native, timing = _timed(lambda: module.unpack_colors(colors), args.repeat)
+    reference, ref = _timed(lambda: array.array("B", (b for b in colors[: sample_vertices * 4])), 1)
+    ok = native.tobytes() == colors and reference.tobytes() == colors[: sample_vertices * 4]
+    report.row("fastmesh.unpack_colors" + label, len(colors), vertices, timing, ref.p50 * scale, ok)
+
+    repacked, timing = _timed(lambda: module.pack_colors(native), args.repeat)
+    reference, ref = _timed(lambda: bytes(b for b in native[: sample_vertices * 4]), 1)
+    report.row("fastmesh.pack_colors" + label, len(colors), vertices, timing, ref.p50 * scale, repacked == colors)
+
+    bones = 8
+    weights = rng.randbytes(vertices * 2 * bones)
+    native, timing = _timed(lambda: module.unpack_weights(weights, bones), args.repeat)
+    reference, ref = _timed(lambda: reference_unpack_weights(weights[: sample_vertices * 2 * bones], bones), 1)
+    sample = module.unpack_weights(weights[: sample_vertices * 2 * bones], bones)
+    ok = all(a.tobytes() == b.tobytes() for a, b in zip(sample, reference))
+    report.row("fastmesh.unpack_weights" + label, len(weights), vertices, timing, ref.p50 * scale, ok)
+
+    repacked, timing = _timed(lambda: module.pack_weights(*native, bones=bones), args.repeat)
+    reference, ref = _timed(lambda: reference_pack_weights(*sample, bones), 1)
+    ok = repacked == weights and reference == weights[: sample_vertices * 2 * bones]
+    report.row("fastmesh.pack_weights" + label, len(weights), vertices, timing, ref.p50 * scale, ok)
+
+    indices = rng.randbytes(vertices * 4)
+    native, timing = _timed(lambda: module.unpack_indices(indices, 4), args.repeat)
+    reference, ref = _timed(lambda: array.array("I", (v for (v,) in struct.iter_unpack("<I", indices[: sample_vertices * 4]))), 1)
+    ok = native.tobytes() == indices and reference.tobytes() == indices[: sample_vertices * 4]
+    report.row("fastmesh.unpack_indices" + label, len(indices), vertices, timing, ref.p50 * scale, ok)
+
+    repacked, timing = _timed(lambda: module.pack_indices(native, 4), args.repeat)
+    reference, ref = _timed(lambda: b"".join(struct.pack("<I", v) for v in native[:sample_vertices]), 1)
+    ok = repacked == indices and reference == indices[: sample_vertices * 4]
+    report.row("fastmesh.pack_indices" + label, len(indices), vertices, timing, ref.p50 * scale, ok)
+
+
+def _size_list(text: str) -> tuple[int, ...]:
+    """Comma-separated sizes with optional k/M/G suffixes, e.g. 10k,1M,5M."""
+    multipliers = {"k": 10**3, "m": 10**6, "g": 10**9}
+    sizes = []
+    for item in text.split(","):
+        item = item.strip().lower()
+        multiplier = multipliers.get(item[-1:], 1)
+        sizes.append(int(float(item[:-1] if multiplier > 1 else item) * multiplier))
+    if not sizes or min(sizes) <= 0:
+        raise argparse.ArgumentTypeError(f"expected positive sizes, got {text!r}")
+    return tuple(sizes)
+
+
+def _environment(modules: dict) -> dict:
+    return {
+        "python": platform.python_version(),
+        "platform": platform.platform(),
+        "machine": platform.machine(),
+        "cpu_count": os.cpu_count(),
+        "modules": {name: Path(module.__file__).name for name, module in modules.items() if module},
+    }
+
+
+def main(argv=None) -> int:
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--paths", type=Path, help="path list, one path per line (replaces the synthetic path counts)")
+    parser.add_argument("--pak", type=Path, help="unencrypted .pak whose TOC hashes are resolved against")
+    parser.add_argument("--binary", type=Path, help="binary to scan for strings, e.g. the game executable (replaces the synthetic sizes)")
+    parser.add_argument("--module-dir", type=Path, help="directory holding freshly built extension modules")
+    parser.add_argument("--scale", choices=sorted(SCALES), default="quick", help="synthetic input sizes (default quick)")
+    parser.add_argument("--path-counts", type=_size_list, help="synthetic path counts, e.g. 10k,1M,5M")
+    parser.add_argument("--binary-mb", type=_size_list, help="synthetic binary sizes in MB, e.g. 100,1024")
+    parser.add_argument("--vertices", type=_size_list, help="synthetic vertex counts, e.g. 100k,1M,5M")
+    parser.add_argument("--threads", type=int, default=0, help="worker threads for threaded APIs (0 = all cores)")
+    parser.add_argument("--repeat", type=int, default=5, help="timed native runs per case; p50 and p99 are taken over them")
+    parser.add_argument("--min-length", type=int, default=4)
+    parser.add_argument("--reference-items", type=int, default=20_000, help="items run through the slow references")
+    parser.add_argument("--reference-bytes", type=int, default=1 << 20, help="bytes scanned by the reference scanner")
+    parser.add_argument("--seed", type=int, default=1)
+    parser.add_argument("--json", type=Path, help="write the results as JSON, for diffing runs over time")
+    parser.add_argument("--baseline", type=Path, help="JSON from an earlier run; p50 changes are shown per case")
+    parser.add_argument("--max-regression", type=float, help="with --baseline, fail cases whose p50 grew by more than this fraction")
+    args = parser.parse_args(argv)
+
+    baseline = None
+    if args.baseline:
+        try:
+            baseline = json.loads(args.baseline.read_text(encoding="utf-8"))
+        except (OSError, ValueError) as exc:
+            parser.error(f"cannot read baseline {args.baseline}: {exc}")
+    if args.module_dir:
+        sys.path.insert(0, str(args.module_dir.resolve()))
+    scale = SCALES[args.scale]
+    rng = random.Random(args.seed)
+    report = Report(baseline, args.max_regression)
+
+    modules = {}
+    for name in MODULES:
+        module, detail = _load_native(name)
+        if module is None:
+            report.fail(name, detail)
+        modules[name] = module
+
+    path_counts = args.path_counts or scale["paths"]
+    paths = args.paths.read_text(encoding="utf-8").split() if args.paths else synthetic_paths(max(path_counts), rng)
+    if args.paths:
+        path_counts = (len(paths),)
+
+    if modules["fast_pakresolve"]:
+        toc_hashes = read_pak_hashes(args.pak) if args.pak else None
+        if toc_hashes is None:
+            if args.pak:
+                print(f"{args.pak}: not an unencrypted PAK, using hashes of every other path instead")
+            known = paths[: args.reference_items : 2]
+            noise = [rng.getrandbits(64) for _ in range(len(known))]
+            tocs = {encoding: [path_hash(p, encoding) for p in known] + noise for encoding in ("utf-16le", "utf-8")}
+        else:
+            tocs = {"utf-16le": toc_hashes, "utf-8": toc_hashes}
+        bench_murmur3(modules["fast_pakresolve"], report, paths, args)
+        for count in path_counts:
+            bench_resolve(modules["fast_pakresolve"], report, paths[:count], tocs, args)
+
+    if modules["fast_string_scan"]:
+        if args.binary:
+            bench_string_scan(modules["fast_string_scan"], report, args.binary.read_bytes(), args)
+        else:
+            # generated smallest first and dropped after each case, so the RSS column tracks the input size
+            for mb in sorted(args.binary_mb or scale["binary_mb"]):
+                bench_string_scan(modules["fast_string_scan"], report, synthetic_binary(mb << 20, paths, rng), args)
+
+    if modules["fastmesh"]:
+        for vertices in args.vertices or scale["vertices"]:
+            bench_fastmesh(modules["fastmesh"], report, vertices, rng, args)
+
+    if args.json:
+        document = {
+            "schema": 1,
+            "timestamp": int(time.time()),
+            "environment": _environment(modules),
+            "settings": {
+                "scale": args.scale, "threads": args.threads, "repeat": args.repeat, "seed": args.seed,
+                "min_length": args.min_length, "reference_items": args.reference_items,
+                "reference_bytes": args.reference_bytes,
+            },
+            "cases": report.cases,
+            "failures": report.failures,
+        }
+        args.json.write_text(json.dumps(document, indent=2) + "\n", encoding="utf-8")
+
+    if report.failures:
+        print("FAILED: " + ", ".join(report.failures))
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
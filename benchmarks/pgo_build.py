@@ -0,0 +1,81 @@
+#!/usr/bin/env python3
+"""Profile-guided build of the native extension modules.
+
+Builds instrumented modules into a scratch directory, trains them on the
+native_modules.py workload (synthetic by default, or real samples passed
+through), then rebuilds the modules in place with the collected profile and LTO.
+
+    python benchmarks/pgo_build.py
+    python benchmarks/pgo_build.py -- --paths natives_list.txt --pak re_chunk_000.pak --binary game.exe
+
+Arguments after -- go to native_modules.py. Profiles live in build/pgo unless
+REASY_NATIVE_PGO_DIR says otherwise; the final parity run must pass.
+"""
+
+from __future__ import annotations
+
+import argparse
+import os
+import shutil
+import subprocess
+import sys
+import sysconfig
+from pathlib import Path
+
+ROOT = Path(__file__).resolve().parent.parent
+WORKLOAD = Path(__file__).resolve().parent / "native_modules.py"
+
+
+def _build(env: dict, *args: str) -> None:
+    subprocess.check_call([sys.executable, "setup.py", "-q", "build_ext", "--force", *args], cwd=ROOT, env=env)
+
+
+def _merge_clang_profiles(profile_dir: Path) -> None:
+    raw = sorted(str(path) for path in profile_dir.glob("*.profraw"))
+    if not raw:
+        raise SystemExit(f"no .profraw profiles were written to {profile_dir}")
+    subprocess.check_call(["llvm-profdata", "merge", "-o", str(profile_dir / "default.profdata"), *raw])
+
+
+def main(argv=None) -> int:
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--no-lto", action="store_true", help="skip link-time optimization in the final build")
+    parser.add_argument("--repeat", type=int, default=3, help="training passes over the workload")
+    parser.add_argument("workload", nargs=argparse.REMAINDER, help="-- followed by native_modules.py arguments")
+    args = parser.parse_args(argv)
+    workload = args.workload[1:] if args.workload[:1] == ["--"] else args.workload
+
+    profile_dir = Path(os.environ.get("REASY_NATIVE_PGO_DIR", ROOT / "build" / "pgo")).resolve()
+    scratch = ROOT / "build" / "pgo-instrumented"
+    # GCC names each .gcda after its object path, so both builds must compile into the same temp dir
+    build_temp = str(ROOT / "build" / "pgo-temp")
+    shutil.rmtree(profile_dir, ignore_errors=True)
+    shutil.rmtree(scratch, ignore_errors=True)
+    profile_dir.mkdir(parents=True)
+    env = dict(os.environ, REASY_NATIVE_PGO_DIR=str(profile_dir))
+    env.pop("REASY_NATIVE_LTO", None)
+
+    print(f"pgo: building instrumented modules into {scratch}")
+    _build(dict(env, REASY_NATIVE_PGO="generate"), "--build-lib", str(scratch), "--build-temp", build_temp)
+    print("pgo: training")
+    train_env = dict(env, LLVM_PROFILE_FILE=str(profile_dir / "reasy-%p.profraw"))
+    command = [sys.executable, str(WORKLOAD), "--module-dir", str(scratch), "--repeat", str(args.repeat), *workload]
+    subprocess.check_call(command, cwd=ROOT, env=train_env)
+
+    final_env = dict(env, REASY_NATIVE_PGO="use")
+    if "clang" in (sysconfig.get_config_var("CC") or ""):
+        _merge_clang_profiles(profile_dir)
+    elif os.name != "nt":
+        # a module whose profile was not found would otherwise build as a plain -O3 module
+        final_env["CFLAGS"] = f"{env.get('CFLAGS', '')} -Werror=missing-profile".strip()
+    if not args.no_lto:
+        final_env["REASY_NATIVE_LTO"] = "1"
+    print("pgo: building optimized modules in place")
+    _build(final_env, "--inplace", "--build-temp", build_temp)
+    print("pgo: checking the optimized modules")
+    subprocess.check_call([sys.executable, str(WORKLOAD), "--module-dir", str(ROOT), "--repeat", "1", *workload], cwd=ROOT)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
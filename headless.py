@@ -0,0 +1,336 @@
+"""Headless batch pipeline over the native modules, started with ``REasy.py --batch``.
+
+Runs nightly-style mass jobs without importing Qt: resolving PAK entry names
+from a path list, scanning binaries for path strings, extracting resolved PAK
+entries, and converting MESH vertex buffers to plain attribute columns. Files
+are spread over a thread or process pool and each native call gets its own
+worker threads; a JSON throughput report is written at the end.
+
+    REasy.py --batch resolve --list natives_list.txt re_chunk_000.pak re_chunk_000.pak.patch_*.pak
+    REasy.py --batch scan --pak re_chunk_000.pak --output found.txt game.exe
+    REasy.py --batch extract --list natives_list.txt --output out/ re_chunk_000.pak
+    REasy.py --batch mesh --layout 0x100:12:float3 --layout 0x2000:8:snorm8x3 --output columns/ *.mesh.*
+"""
+
+from __future__ import annotations
+
+import argparse
+import importlib.machinery
+import json
+import mmap
+import os
+import sys
+import time
+from concurrent.futures import ProcessPoolExecutor, ThreadPoolExecutor
+from pathlib import Path
+
+PAK_ENTRY_SIZES = {2: 24, 4: 48}
+
+# Per-process job state, set up once by _init_worker so process pools do not
+# re-send the path list or hash index with every file.
+_STATE: dict = {}
+
+
+def _prepare_native_modules() -> None:
+    # Same preparation as application._prepare_native_modules, minus Qt.
+    from utils.native_build import ensure_fastmesh, ensure_fast_pakresolve
+
+    ensure_fast_pakresolve()
+    ensure_fastmesh()
+    import fast_string_scan
+
+    origin = getattr(fast_string_scan, "__file__", "") or ""
+    if not origin.endswith(tuple(importlib.machinery.EXTENSION_SUFFIXES)):
+        raise ImportError(f"fast_string_scan is not a compiled extension ({origin or 'built-in'})")
+
+
+def read_path_list(path: Path) -> list[str]:
+    with path.open(encoding="utf-8", errors="replace") as fh:
+        return [line.strip() for line in fh if line.strip()]
+
+
+def read_pak_toc(path: Path):
+    """Parse the entry table of an unencrypted PAK without reading entry data."""
+    import fast_pakresolve
+
+    with path.open("rb") as fh:
+        header = fh.read(16)
+        entry_size = PAK_ENTRY_SIZES.get(header[4]) if len(header) >= 16 else None
+        count = int.from_bytes(header[8:12], "little") if entry_size else 0
+        table = fh.read(count * entry_size) if entry_size else b""
+    return fast_pakresolve.parse_pak_toc(header + table)
+
+
+def _combined_index(paks: list[str]):
+    import fast_pakresolve
+
+    hashes = []
+    for pak in paks:
+        toc = read_pak_toc(Path(pak))
+        hashes.extend((hi << 32) | lo for lo, hi in zip(toc.hash_lo, toc.hash_hi))
+    return fast_pakresolve.PakHashIndex(hashes)
+
+
+def _init_worker(options: dict) -> None:
+    _STATE.clear()
+    _STATE.update(options)
+    if options.get("list"):
+        _STATE["paths"] = read_path_list(Path(options["list"]))
+    if options.get("paks"):
+        _STATE["index"] = _combined_index(options["paks"])
+
+
+def _record(path: Path, **fields) -> dict:
+    return {"file": str(path), **fields}
+
+
+# Jobs --------------------------------------------------------------------------------------------
+
+def _resolve_file(name: str) -> dict:
+    import fast_pakresolve
+
+    path = Path(name)
+    start = time.perf_counter()
+    toc = read_pak_toc(path)
+    index = fast_pakresolve.PakHashIndex(toc)
+    paths = _STATE["paths"]
+    _, path_indices, toc_indices = fast_pakresolve.resolve_paths_utf16le(index, paths, threads=_STATE["threads"])
+    if _STATE.get("output"):
+        resolved = sorted(zip(toc_indices, path_indices))
+        target = Path(_STATE["output"]) / f"{path.name}.txt"
+        target.write_text("".join(f"{paths[i]}\n" for _, i in resolved), encoding="utf-8")
+    seconds = time.perf_counter() - start
+    return _record(path, bytes=path.stat().st_size, items=len(paths), seconds=seconds,
+                   entries=len(toc), resolved=len(path_indices))
+
+
+def _scan_file(name: str) -> dict:
+    import fast_pakresolve
+    import fast_string_scan
+
+    path = Path(name)
+    start = time.perf_counter()
+    with path.open("rb") as fh:
+        size = os.fstat(fh.fileno()).st_size
+        if not size:
+            return _record(path, bytes=0, items=0, seconds=time.perf_counter() - start, strings=[])
+        with mmap.mmap(fh.fileno(), 0, access=mmap.ACCESS_READ) as view:
+            if "index" in _STATE:
+                hits = fast_pakresolve.scan_resolve(view, _STATE["index"], min_length=_STATE["min_length"],
+                                                    extensions=_STATE["extensions"], threads=_STATE["threads"])
+                strings = [hit[0] for hit in hits]
+            else:
+                strings = fast_string_scan.extract_strings(view, _STATE["min_length"], threads=_STATE["threads"])
+    return _record(path, bytes=size, items=len(strings), seconds=time.perf_counter() - start, strings=strings)
+
+
+def _extract_pak(path: Path, claimed: set[str], threads: int) -> dict:
+    import fast_pakresolve
+
+    start = time.perf_counter()
+    toc = read_pak_toc(path)
+    paths = _STATE["paths"]
+    _, path_indices, toc_indices = fast_pakresolve.resolve_paths_utf16le(fast_pakresolve.PakHashIndex(toc), paths, threads=threads)
+    root = Path(_STATE["output"])
+    indices, outputs = [], []
+    for path_index, toc_index in zip(path_indices, toc_indices):
+        name = paths[path_index]
+        key = name.lower()
+        if key in claimed:
+            continue
+        claimed.add(key)
+        target = root / name
+        target.parent.mkdir(parents=True, exist_ok=True)
+        indices.append(toc_index)
+        outputs.append(target)
+    status, written = fast_pakresolve.extract_entries(path, toc, indices, outputs, threads=threads)
+    codes = {
+        "ok": fast_pakresolve.EXTRACT_OK,
+        "read_error": fast_pakresolve.EXTRACT_READ_ERROR,
+        "write_error": fast_pakresolve.EXTRACT_WRITE_ERROR,
+        "unsupported": fast_pakresolve.EXTRACT_UNSUPPORTED,
+        "decompress_error": fast_pakresolve.EXTRACT_DECOMPRESS_ERROR,
+    }
+    counts = {label: status.count(code) for label, code in codes.items()}
+    return _record(path, bytes=written, items=len(indices), seconds=time.perf_counter() - start,
+                   entries=len(toc), resolved=len(path_indices), status=counts)
+
+
+def _components(fmt: str) -> int:
+    # "float3" and "snorm8x3" carry a count; "uint16" and "snorm8" end in their type width
+    return int(fmt[-1]) if fmt[-1] in "1234" and not fmt[-2].isdigit() else 1
+
+
+def _mesh_file(name: str) -> dict:
+    import fastmesh
+
+    path = Path(name)
+    start = time.perf_counter()
+    layout = _STATE["layout"]
+    with path.open("rb") as fh:
+        size = os.fstat(fh.fileno()).st_size
+        if not size:
+            raise ValueError("empty file")
+        with mmap.mmap(fh.fileno(), 0, access=mmap.ACCESS_READ) as view:
+            columns = fastmesh.decode_vertices(view, layout, _STATE["count"])
+    vertices = len(columns[0]) // _components(layout[0][2]) if columns else 0
+    placed, offset = [], 0
+    for (_, _, fmt), column in zip(layout, columns):
+        length = len(column) * column.itemsize
+        placed.append({"format": fmt, "typecode": column.typecode, "offset": offset, "bytes": length})
+        offset += length
+    if _STATE.get("output"):
+        # one native write places every column at its offset; no concatenated copy is built
+        target = Path(_STATE["output"]) / f"{path.name}.columns"
+        fastmesh.write_streams(target, [(entry["offset"], "bytes", (column,)) for entry, column in zip(placed, columns)])
+    return _record(path, bytes=size, items=vertices, seconds=time.perf_counter() - start, columns=placed)
+
+
+# Driver ------------------------------------------------------------------------------------------
+
+def _failed(name: str, exc: Exception) -> dict:
+    return _record(Path(name), bytes=0, items=0, seconds=0.0, error=f"{type(exc).__name__}: {exc}")
+
+
+def _guarded(job, name: str) -> dict:
+    try:
+        return job(name)
+    except (OSError, ValueError) as exc:
+        return _failed(name, exc)
+
+
+def _run_pool(job, files: list[str], options: dict, jobs: int, processes: bool) -> list[dict]:
+    if jobs <= 1 or len(files) <= 1:
+        _init_worker(options)
+        return [_guarded(job, name) for name in files]
+    if processes:
+        pool = ProcessPoolExecutor(max_workers=jobs, initializer=_init_worker, initargs=(options,))
+    else:
+        _init_worker(options)
+        pool = ThreadPoolExecutor(max_workers=jobs)
+    with pool:
+        futures = [pool.submit(_guarded, job, name) for name in files]
+        return [future.result() for future in futures]
+
+
+def _report(command: str, records: list[dict], seconds: float, jobs: int, threads: int, pool: str) -> dict:
+    size = sum(record["bytes"] for record in records)
+    items = sum(record["items"] for record in records)
+    elapsed = max(seconds, 1e-9)
+    return {
+        "command": command,
+        "pool": pool,
+        "jobs": jobs,
+        "threads": threads,
+        "seconds": seconds,
+        "files": len(records),
+        "failed": sum(1 for record in records if "error" in record),
+        "bytes": size,
+        "items": items,
+        "mb_per_s": size / elapsed / 1e6,
+        "items_per_s": items / elapsed,
+        "results": records,
+    }
+
+
+def _layout_element(text: str) -> tuple[int, int, str]:
+    try:
+        offset, stride, fmt = text.split(":")
+        return int(offset, 0), int(stride, 0), fmt
+    except ValueError:
+        raise argparse.ArgumentTypeError(f"expected OFFSET:STRIDE:FORMAT, got {text!r}") from None
+
+
+def _build_parser() -> argparse.ArgumentParser:
+    parser = argparse.ArgumentParser(prog="REasy --batch", description=__doc__.splitlines()[0])
+    parser.add_argument("--jobs", type=int, default=0, help="files processed at once (0 = one per core, capped by the file count)")
+    parser.add_argument("--threads", type=int, default=0, help="native worker threads per file (0 = cores divided between jobs)")
+    parser.add_argument("--processes", action="store_true", help="use a process pool instead of threads")
+    parser.add_argument("--report", default="-", help="JSON report path, or - for stdout")
+    commands = parser.add_subparsers(dest="command", required=True)
+
+    resolve = commands.add_parser("resolve", help="resolve PAK entry names from a path list")
+    resolve.add_argument("files", nargs="+", metavar="pak")
+    resolve.add_argument("--list", type=Path, required=True, help="path list, one path per line")
+    resolve.add_argument("--output", type=Path, help="directory receiving <pak>.txt with the resolved paths")
+
+    scan = commands.add_parser("scan", help="extract strings from binaries, or the paths some PAKs contain")
+    scan.add_argument("files", nargs="+", metavar="binary")
+    scan.add_argument("--pak", action="append", default=[], help="only report strings whose hash is in this PAK (repeatable)")
+    scan.add_argument("--min-length", type=int, default=5)
+    scan.add_argument("--extension", action="append", dest="extensions", help="with --pak, only probe paths with this extension (repeatable)")
+    scan.add_argument("--output", type=Path, help="file receiving the sorted unique strings")
+
+    extract = commands.add_parser("extract", help="extract the resolved entries of PAKs; later PAKs win, like patch PAKs")
+    extract.add_argument("files", nargs="+", metavar="pak")
+    extract.add_argument("--list", type=Path, required=True, help="path list, one path per line")
+    extract.add_argument("--output", type=Path, required=True, help="directory the entries are written under")
+
+    mesh = commands.add_parser("mesh", help="decode MESH vertex buffers into float/integer attribute columns")
+    mesh.add_argument("files", nargs="+", metavar="mesh")
+    mesh.add_argument("--layout", type=_layout_element, action="append", required=True,
+                      help="OFFSET:STRIDE:FORMAT of one attribute, offsets counted from the file start (repeatable)")
+    mesh.add_argument("--count", type=int, help="vertices to decode (default: as many as every attribute holds)")
+    mesh.add_argument("--output", type=Path, help="directory receiving <mesh>.columns with the decoded attributes back to back")
+    return parser
+
+
+def main(argv=None) -> int:
+    args = _build_parser().parse_args(argv)
+    if args.jobs < 0 or args.threads < 0:
+        print("--jobs and --threads must be >= 0", file=sys.stderr)
+        return 2
+    _prepare_native_modules()
+
+    files = args.files
+    cores = os.cpu_count() or 1
+    jobs = 1 if args.command == "extract" else min(args.jobs or cores, len(files))
+    threads = args.threads or (0 if jobs == 1 else max(1, cores // jobs))
+    pool = "serial" if jobs == 1 else "process" if args.processes else "thread"
+    options = {"threads": threads}
+
+    start = time.perf_counter()
+    if args.command == "resolve":
+        if args.output:
+            args.output.mkdir(parents=True, exist_ok=True)
+        options.update(list=str(args.list), output=str(args.output) if args.output else None)
+        records = _run_pool(_resolve_file, files, options, jobs, args.processes)
+    elif args.command == "scan":
+        options.update(min_length=args.min_length, extensions=args.extensions, paks=args.pak)
+        records = _run_pool(_scan_file, files, options, jobs, args.processes)
+        found = set()
+        for record in records:
+            found.update(record.pop("strings", ()))
+        if args.output:
+            args.output.write_text("".join(f"{text}\n" for text in sorted(found)), encoding="utf-8")
+    elif args.command == "mesh":
+        if args.output:
+            args.output.mkdir(parents=True, exist_ok=True)
+        options.update(layout=args.layout, count=args.count, output=str(args.output) if args.output else None)
+        records = _run_pool(_mesh_file, files, options, jobs, args.processes)
+    else:
+        options.update(list=str(args.list), output=str(args.output))
+        _init_worker(options)
+        # Walk newest-first so an entry shadowed by a later PAK is taken from that PAK only.
+        claimed: set[str] = set()
+        records = {}
+        for name in reversed(files):
+            try:
+                records[name] = _extract_pak(Path(name), claimed, threads)
+            except (OSError, ValueError) as exc:
+                records[name] = _failed(name, exc)
+        records = [records[name] for name in files]
+    report = _report(args.command, records, time.perf_counter() - start, jobs, threads, pool)
+    if args.command == "scan":
+        report["unique"] = len(found)
+
+    text = json.dumps(report, indent=2)
+    if args.report == "-":
+        print(text)
+    else:
+        Path(args.report).write_text(text + "\n", encoding="utf-8")
+    return 1 if report["failed"] else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -1,6 +1,35 @@
 #define PY_SSIZE_T_CLEAN
 #include <Python.h>
 #include <stdint.h>
+#include <string.h>
+#include <stdlib.h>
+#include <structmember.h>
+#include "native_cpu.h"
+#include "native_file.h"
+#include "native_parallel.h"
+#include "native_scan.h"
+#include "native_stats.h"
+
+/* Phase timers (*_ns) and counters behind stats(); see native_stats.h. */
+enum {
+	STAT_TOC_NS, STAT_TOC_ENTRIES,
+	STAT_RESOLVE_CALLS, STAT_PATHS, STAT_ASCII_PATHS, STAT_FOLD_NS, STAT_STRINGS_ALLOCATED,
+	STAT_HASH_NS, STAT_BYTES_HASHED, STAT_INDEX_HITS, STAT_INDEX_MISSES,
+	STAT_COLLECT_NS, STAT_DICT_HITS, STAT_DICT_MISSES, STAT_PATHS_SET,
+	STAT_PROBE_NS, STAT_PROBE_CANDIDATES, STAT_PROBE_HITS,
+	STAT_SCAN_NS, STAT_SCAN_BYTES, STAT_SCAN_HITS,
+	STAT_EXTRACT_NS, STAT_EXTRACT_ENTRIES, STAT_EXTRACT_BYTES,
+};
+static const char* const stat_names[] = {
+	"toc_ns", "toc_entries",
+	"resolve_calls", "paths", "ascii_paths", "fold_ns", "strings_allocated",
+	"hash_ns", "bytes_hashed", "index_hits", "index_misses",
+	"collect_ns", "dict_hits", "dict_misses", "paths_set",
+	"probe_ns", "probe_candidates", "probe_hits",
+	"scan_ns", "scan_bytes", "scan_hits",
+	"extract_ns", "extract_entries", "extract_bytes",
+};
+static native_stats stats = NATIVE_STATS_INIT(stat_names);
 
 static inline uint32_t rotl32(uint32_t x, int8_t r) {
 	return (x << r) | (x >> (32 - r));
@@ -27,6 +56,558 @@ static uint32_t murmur3_32(const uint8_t* data, Py_ssize_t len, uint32_t seed) {
 	h1 ^= (uint32_t)len; return fmix32(h1);
 }
 
+static inline uint32_t ascii_lower(uint32_t c) { return c - 'A' < 26U ? c + 32U : c; }
+static inline uint32_t ascii_upper(uint32_t c) { return c - 'a' < 26U ? c - 32U : c; }
+static inline uint32_t murmur3_mix_k(uint32_t k1) { k1 *= 0xcc9e2d51U; k1 = rotl32(k1, 15); return k1 * 0x1b873593U; }
+static inline uint32_t murmur3_mix_h(uint32_t h1, uint32_t k1) { h1 ^= murmur3_mix_k(k1); h1 = rotl32(h1, 13); return h1 * 5 + 0xe6546b64U; }
+
+/* Hashes str.lower() and str.upper() of an ASCII string in one pass, folding and (optionally)
+ * widening to UTF-16LE on the fly; bit-identical to murmur3_32 over the encoded variants. */
+static void murmur3_32_ascii_pair(const uint8_t* s, Py_ssize_t n, int utf16, uint32_t seed, uint32_t* lo_out, uint32_t* up_out) {
+	uint32_t hl = seed, hu = seed, kl = 0, ku = 0; Py_ssize_t i = 0;
+	if (utf16) {
+		for (; i + 2 <= n; i += 2) {
+			hl = murmur3_mix_h(hl, ascii_lower(s[i]) | (ascii_lower(s[i+1]) << 16));
+			hu = murmur3_mix_h(hu, ascii_upper(s[i]) | (ascii_upper(s[i+1]) << 16));
+		}
+	} else {
+		for (; i + 4 <= n; i += 4) {
+			hl = murmur3_mix_h(hl, ascii_lower(s[i]) | (ascii_lower(s[i+1]) << 8) | (ascii_lower(s[i+2]) << 16) | (ascii_lower(s[i+3]) << 24));
+			hu = murmur3_mix_h(hu, ascii_upper(s[i]) | (ascii_upper(s[i+1]) << 8) | (ascii_upper(s[i+2]) << 16) | (ascii_upper(s[i+3]) << 24));
+		}
+	}
+	if (i < n) {
+		for (int shift = 0; i < n; ++i, shift += 8) { kl |= ascii_lower(s[i]) << shift; ku |= ascii_upper(s[i]) << shift; }
+		hl ^= murmur3_mix_k(kl); hu ^= murmur3_mix_k(ku);
+	}
+	uint32_t len = (uint32_t)(utf16 ? n * 2 : n);
+	*lo_out = fmix32(hl ^ len); *up_out = fmix32(hu ^ len);
+}
+
+/* Multi-lane murmur3: each SIMD lane carries an independent hash stream. Lanes advance together
+ * over their shared whole-block prefix; a lane that runs out of blocks is finished in scalar code
+ * and refilled with the next buffer, so mixed lengths keep every lane busy. */
+#define MURMUR_MAX_LANES 8
+
+typedef struct {
+	const uint8_t* const* bufs; const Py_ssize_t* lens; Py_ssize_t count; Py_ssize_t next;
+	uint32_t seed; uint32_t* out;
+	uint32_t h[MURMUR_MAX_LANES]; const uint8_t* ptr[MURMUR_MAX_LANES];
+	Py_ssize_t rem[MURMUR_MAX_LANES]; Py_ssize_t item[MURMUR_MAX_LANES];
+} murmur_lanes;
+
+static inline uint32_t load_le32(const uint8_t* p) {
+	return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static uint32_t murmur3_32_finish(uint32_t h1, const uint8_t* data, Py_ssize_t rem, Py_ssize_t total) {
+	for (; rem >= 4; rem -= 4, data += 4) h1 = murmur3_mix_h(h1, load_le32(data));
+	uint32_t k1 = 0; switch (rem) {
+		case 3: k1 ^= ((uint32_t)data[2] << 16);
+		case 2: k1 ^= ((uint32_t)data[1] << 8);
+		case 1: k1 ^= ((uint32_t)data[0]); h1 ^= murmur3_mix_k(k1);
+	}
+	h1 ^= (uint32_t)total; return fmix32(h1);
+}
+
+/* Finishes lanes that have no whole block left and loads the next buffers into them.
+ * Returns the number of blocks every live lane can still take, or 0 when all are drained. */
+static Py_ssize_t lanes_refill(murmur_lanes* st, int lanes) {
+	Py_ssize_t blocks = PY_SSIZE_T_MAX; int live = 0;
+	for (int l = 0; l < lanes; ++l) {
+		while (st->item[l] >= 0 && st->rem[l] < 4) {
+			Py_ssize_t it = st->item[l];
+			st->out[it] = murmur3_32_finish(st->h[l], st->ptr[l], st->rem[l], st->lens[it]);
+			st->item[l] = -1;
+			if (st->next < st->count) {
+				it = st->next++;
+				st->item[l] = it; st->h[l] = st->seed; st->ptr[l] = st->bufs[it]; st->rem[l] = st->lens[it];
+			}
+		}
+		if (st->item[l] < 0) continue;
+		live++;
+		if (st->rem[l] / 4 < blocks) blocks = st->rem[l] / 4;
+	}
+	return live ? blocks : 0;
+}
+
+/* Vector rounds only pay off while every lane is live; the stragglers are finished in scalar code. */
+static int lanes_all_live(const murmur_lanes* st, int lanes) {
+	for (int l = 0; l < lanes; ++l) if (st->item[l] < 0) return 0;
+	return 1;
+}
+
+static void lanes_start(murmur_lanes* st, int lanes) {
+	for (int l = 0; l < lanes; ++l) { st->item[l] = -1; st->rem[l] = 0; }
+	for (int l = 0; l < lanes && st->next < st->count; ++l) {
+		Py_ssize_t it = st->next++;
+		st->item[l] = it; st->h[l] = st->seed; st->ptr[l] = st->bufs[it]; st->rem[l] = st->lens[it];
+	}
+}
+
+static void lanes_drain(murmur_lanes* st, int lanes) {
+	for (int l = 0; l < lanes; ++l) {
+		if (st->item[l] < 0) continue;
+		st->out[st->item[l]] = murmur3_32_finish(st->h[l], st->ptr[l], st->rem[l], st->lens[st->item[l]]);
+		st->item[l] = -1;
+	}
+	for (; st->next < st->count; ++st->next) {
+		Py_ssize_t it = st->next;
+		st->out[it] = murmur3_32_finish(st->seed, st->bufs[it], st->lens[it], st->lens[it]);
+	}
+}
+
+static void lanes_advance(murmur_lanes* st, int lanes, Py_ssize_t blocks) {
+	for (int l = 0; l < lanes; ++l) { st->ptr[l] += blocks * 4; st->rem[l] -= blocks * 4; }
+}
+
+#ifdef NATIVE_X86
+NATIVE_TARGET("sse2") static inline __m128i mullo32_sse2(__m128i a, __m128i b) {
+	__m128i even = _mm_mul_epu32(a, b);
+	__m128i odd = _mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));
+	return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)), _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+}
+
+NATIVE_TARGET("sse2") static void murmur3_many_sse2(murmur_lanes* st) {
+	const __m128i c1 = _mm_set1_epi32((int)0xcc9e2d51U), c2 = _mm_set1_epi32(0x1b873593), c3 = _mm_set1_epi32((int)0xe6546b64U);
+	lanes_start(st, 4);
+	Py_ssize_t blocks;
+	while (lanes_all_live(st, 4) && (blocks = lanes_refill(st, 4)) > 0 && lanes_all_live(st, 4)) {
+		__m128i h = _mm_loadu_si128((const __m128i*)st->h);
+		for (Py_ssize_t b = 0; b < blocks; ++b) {
+			Py_ssize_t o = b * 4;
+			__m128i k = _mm_set_epi32((int)load_le32(st->ptr[3] + o), (int)load_le32(st->ptr[2] + o), (int)load_le32(st->ptr[1] + o), (int)load_le32(st->ptr[0] + o));
+			k = mullo32_sse2(k, c1);
+			k = _mm_or_si128(_mm_slli_epi32(k, 15), _mm_srli_epi32(k, 17));
+			k = mullo32_sse2(k, c2);
+			h = _mm_xor_si128(h, k);
+			h = _mm_or_si128(_mm_slli_epi32(h, 13), _mm_srli_epi32(h, 19));
+			h = _mm_add_epi32(_mm_add_epi32(_mm_slli_epi32(h, 2), h), c3);
+		}
+		_mm_storeu_si128((__m128i*)st->h, h);
+		lanes_advance(st, 4, blocks);
+	}
+	lanes_drain(st, 4);
+}
+
+NATIVE_TARGET("avx2") static void murmur3_many_avx2(murmur_lanes* st) {
+	const __m256i c1 = _mm256_set1_epi32((int)0xcc9e2d51U), c2 = _mm256_set1_epi32(0x1b873593), c3 = _mm256_set1_epi32((int)0xe6546b64U);
+	lanes_start(st, 8);
+	Py_ssize_t blocks;
+	while (lanes_all_live(st, 8) && (blocks = lanes_refill(st, 8)) > 0 && lanes_all_live(st, 8)) {
+		__m256i h = _mm256_loadu_si256((const __m256i*)st->h);
+		for (Py_ssize_t b = 0; b < blocks; ++b) {
+			Py_ssize_t o = b * 4;
+			__m256i k = _mm256_set_epi32(
+				(int)load_le32(st->ptr[7] + o), (int)load_le32(st->ptr[6] + o), (int)load_le32(st->ptr[5] + o), (int)load_le32(st->ptr[4] + o),
+				(int)load_le32(st->ptr[3] + o), (int)load_le32(st->ptr[2] + o), (int)load_le32(st->ptr[1] + o), (int)load_le32(st->ptr[0] + o));
+			k = _mm256_mullo_epi32(k, c1);
+			k = _mm256_or_si256(_mm256_slli_epi32(k, 15), _mm256_srli_epi32(k, 17));
+			k = _mm256_mullo_epi32(k, c2);
+			h = _mm256_xor_si256(h, k);
+			h = _mm256_or_si256(_mm256_slli_epi32(h, 13), _mm256_srli_epi32(h, 19));
+			h = _mm256_add_epi32(_mm256_add_epi32(_mm256_slli_epi32(h, 2), h), c3);
+		}
+		_mm256_storeu_si256((__m256i*)st->h, h);
+		lanes_advance(st, 8, blocks);
+	}
+	lanes_drain(st, 8);
+}
+#endif
+
+#ifdef NATIVE_NEON
+static void murmur3_many_neon(murmur_lanes* st) {
+	const uint32x4_t c1 = vdupq_n_u32(0xcc9e2d51U), c2 = vdupq_n_u32(0x1b873593U), c3 = vdupq_n_u32(0xe6546b64U);
+	lanes_start(st, 4);
+	Py_ssize_t blocks;
+	while (lanes_all_live(st, 4) && (blocks = lanes_refill(st, 4)) > 0 && lanes_all_live(st, 4)) {
+		uint32x4_t h = vld1q_u32(st->h);
+		for (Py_ssize_t b = 0; b < blocks; ++b) {
+			Py_ssize_t o = b * 4;
+			uint32_t words[4] = { load_le32(st->ptr[0] + o), load_le32(st->ptr[1] + o), load_le32(st->ptr[2] + o), load_le32(st->ptr[3] + o) };
+			uint32x4_t k = vmulq_u32(vld1q_u32(words), c1);
+			k = vorrq_u32(vshlq_n_u32(k, 15), vshrq_n_u32(k, 17));
+			k = vmulq_u32(k, c2);
+			h = veorq_u32(h, k);
+			h = vorrq_u32(vshlq_n_u32(h, 13), vshrq_n_u32(h, 19));
+			h = vmlaq_n_u32(c3, h, 5);
+		}
+		vst1q_u32(st->h, h);
+		lanes_advance(st, 4, blocks);
+	}
+	lanes_drain(st, 4);
+}
+#endif
+
+/* Hashes count buffers into out[]; results match murmur3_32 for every buffer. */
+static void murmur3_32_many(const uint8_t* const* bufs, const Py_ssize_t* lens, Py_ssize_t count, uint32_t seed, uint32_t* out) {
+	murmur_lanes st;
+	st.bufs = bufs; st.lens = lens; st.count = count; st.next = 0; st.seed = seed; st.out = out;
+#ifdef NATIVE_X86
+	int features = native_cpu_features();
+	if (features & NATIVE_CPU_AVX2) { murmur3_many_avx2(&st); return; }
+	if (features & NATIVE_CPU_SSE2) { murmur3_many_sse2(&st); return; }
+#endif
+#ifdef NATIVE_NEON
+	murmur3_many_neon(&st); return;
+#endif
+	lanes_drain(&st, 0);
+}
+
+typedef struct { unsigned long long key; Py_ssize_t index; } hash_slot;
+typedef struct { hash_slot* slots; Py_ssize_t mask; int shift; Py_ssize_t count; } hash_table;
+
+static inline Py_ssize_t table_home(const hash_table* t, unsigned long long key) {
+	return (Py_ssize_t)((key * 0x9E3779B97F4A7C15ULL) >> t->shift);
+}
+static int table_init(hash_table* t, Py_ssize_t expected) {
+	Py_ssize_t capacity = 16; int bits = 4;
+	while (capacity < expected * 2) { capacity <<= 1; bits++; }
+	t->slots = (hash_slot*)PyMem_Malloc(capacity * sizeof(hash_slot));
+	if (!t->slots) return -1;
+	for (Py_ssize_t i = 0; i < capacity; ++i) t->slots[i].index = -1;
+	t->mask = capacity - 1; t->shift = 64 - bits; t->count = 0; return 0;
+}
+static void table_free(hash_table* t) { PyMem_Free(t->slots); t->slots = NULL; t->mask = -1; t->count = 0; }
+/* Later inserts of an existing key win, matching how the Python dict cache is filled. */
+static void table_insert(hash_table* t, unsigned long long key, Py_ssize_t index) {
+	Py_ssize_t pos = table_home(t, key);
+	while (t->slots[pos].index >= 0 && t->slots[pos].key != key) pos = (pos + 1) & t->mask;
+	if (t->slots[pos].index < 0) t->count++;
+	t->slots[pos].key = key; t->slots[pos].index = index;
+}
+static inline Py_ssize_t table_find(const hash_table* t, unsigned long long key) {
+	Py_ssize_t pos = table_home(t, key);
+	for (;;) {
+		const hash_slot* slot = &t->slots[pos];
+		if (slot->index < 0) return -1;
+		if (slot->key == key) return slot->index;
+		pos = (pos + 1) & t->mask;
+	}
+}
+
+/* PAK table of contents, parsed into struct-of-arrays columns. Each column is an immutable bytes
+ * object exposed as a typed read-only memoryview, so native code can keep raw column pointers. */
+#define PAK_MAGIC 0x414B504BU
+#define PAK_HEADER_SIZE 16
+#define PAK_FEATURE_ENCRYPTED_TOC 0x0008
+#define PAK_ENTRY_V2_SIZE 24
+#define PAK_ENTRY_V4_SIZE 48
+#define PAK_COMPRESSION_MASK 0xFULL
+#define PAK_COMPRESSION_NONE 0
+#define PAK_COMPRESSION_DEFLATE 1
+#define PAK_COMPRESSION_ZSTD 2
+#define PAK_ENCRYPTION_SHIFT 16
+#define PAK_ENCRYPTION_MASK 0xFULL
+
+enum { TOC_HASH_LO, TOC_HASH_HI, TOC_OFFSET, TOC_COMPRESSED_SIZE, TOC_DECOMPRESSED_SIZE, TOC_FLAGS, TOC_CHECKSUM, TOC_COLUMNS };
+
+typedef struct {
+	PyObject_HEAD
+	int major; int minor; int feature; unsigned int fingerprint; Py_ssize_t count;
+	PyObject* columns[TOC_COLUMNS];
+	const uint32_t* hash_lo; const uint32_t* hash_hi;
+	const unsigned long long* offset; const unsigned long long* compressed_size;
+	const unsigned long long* decompressed_size; const unsigned long long* flags; const unsigned long long* checksum;
+} PakTocObject;
+static PyTypeObject PakTocType;
+
+static inline uint64_t load_le64(const uint8_t* p) { return (uint64_t)load_le32(p) | ((uint64_t)load_le32(p + 4) << 32); }
+
+static PyObject* typed_view(PyObject* bytes, const char* format) {
+	PyObject* raw = PyMemoryView_FromObject(bytes);
+	if (!raw) return NULL;
+	PyObject* view = PyObject_CallMethod(raw, "cast", "s", format);
+	Py_DECREF(raw);
+	return view;
+}
+
+static PyObject* parse_pak_toc(PyObject* self, PyObject* args, PyObject* kwds) {
+	PyObject* source; PyObject* entries_obj = Py_None;
+	static char* kwlist[] = {"header", "entries", NULL};
+	if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|O", kwlist, &source, &entries_obj)) return NULL;
+	Py_buffer header, entries;
+	if (PyObject_GetBuffer(source, &header, PyBUF_SIMPLE) != 0) return NULL;
+	const uint8_t* h = (const uint8_t*)header.buf;
+	if (header.len < PAK_HEADER_SIZE || load_le32(h) != PAK_MAGIC) {
+		PyBuffer_Release(&header); PyErr_SetString(PyExc_ValueError, "not a PAK file (missing KPKA header)"); return NULL;
+	}
+	int major = h[4], minor = h[5], feature = h[6] | (h[7] << 8);
+	Py_ssize_t count = (Py_ssize_t)load_le32(h + 8);
+	unsigned int fingerprint = load_le32(h + 12);
+	Py_ssize_t entry_size = major == 2 ? PAK_ENTRY_V2_SIZE : major == 4 ? PAK_ENTRY_V4_SIZE : 0;
+	if (!entry_size) { PyBuffer_Release(&header); PyErr_Format(PyExc_ValueError, "unsupported PAK version %d.%d", major, minor); return NULL; }
+
+	/* Encrypted tables must be decrypted by the caller and passed separately. */
+	const uint8_t* table; Py_ssize_t table_len;
+	if (entries_obj != Py_None) {
+		if (PyObject_GetBuffer(entries_obj, &entries, PyBUF_SIMPLE) != 0) { PyBuffer_Release(&header); return NULL; }
+		table = (const uint8_t*)entries.buf; table_len = entries.len;
+	} else if (feature & PAK_FEATURE_ENCRYPTED_TOC) {
+		PyBuffer_Release(&header); PyErr_SetString(PyExc_ValueError, "PAK entry table is encrypted; pass the decrypted table as entries="); return NULL;
+	} else {
+		table = h + PAK_HEADER_SIZE; table_len = header.len - PAK_HEADER_SIZE;
+	}
+	PakTocObject* toc = NULL;
+	if (table_len / entry_size < count) {
+		PyErr_Format(PyExc_ValueError, "PAK entry table truncated: %zd of %zd entries present", table_len / entry_size, count);
+		goto done;
+	}
+	toc = PyObject_New(PakTocObject, &PakTocType);
+	if (!toc) goto done;
+	toc->major = major; toc->minor = minor; toc->feature = feature; toc->fingerprint = fingerprint; toc->count = count;
+	uint8_t* col[TOC_COLUMNS];
+	for (int c = 0; c < TOC_COLUMNS; ++c) toc->columns[c] = NULL;
+	for (int c = 0; c < TOC_COLUMNS; ++c) {
+		Py_ssize_t width = c <= TOC_HASH_HI ? 4 : 8;
+		if (!(toc->columns[c] = PyBytes_FromStringAndSize(NULL, count * width))) { Py_CLEAR(toc); goto done; }
+		col[c] = (uint8_t*)PyBytes_AS_STRING(toc->columns[c]);
+	}
+	uint32_t* lo = (uint32_t*)col[TOC_HASH_LO]; uint32_t* hi = (uint32_t*)col[TOC_HASH_HI];
+	unsigned long long* off = (unsigned long long*)col[TOC_OFFSET]; unsigned long long* csz = (unsigned long long*)col[TOC_COMPRESSED_SIZE];
+	unsigned long long* dsz = (unsigned long long*)col[TOC_DECOMPRESSED_SIZE]; unsigned long long* flg = (unsigned long long*)col[TOC_FLAGS];
+	unsigned long long* sum = (unsigned long long*)col[TOC_CHECKSUM];
+	unsigned long long started = native_stats_clock(&stats);
+	Py_BEGIN_ALLOW_THREADS
+	for (Py_ssize_t i = 0; i < count; ++i) {
+		const uint8_t* e = table + i * entry_size;
+		if (major == 2) {
+			off[i] = load_le64(e); dsz[i] = csz[i] = load_le64(e + 8);
+			lo[i] = load_le32(e + 16); hi[i] = load_le32(e + 20);
+			flg[i] = 0ULL; sum[i] = 0ULL;
+		} else {
+			lo[i] = load_le32(e); hi[i] = load_le32(e + 4);
+			off[i] = load_le64(e + 8); csz[i] = load_le64(e + 16); dsz[i] = load_le64(e + 24);
+			flg[i] = load_le64(e + 32); sum[i] = load_le64(e + 40);
+		}
+	}
+	Py_END_ALLOW_THREADS
+	native_stats_time(&stats, 0, STAT_TOC_NS, started);
+	native_stats_add(&stats, 0, STAT_TOC_ENTRIES, count);
+	toc->hash_lo = lo; toc->hash_hi = hi; toc->offset = off; toc->compressed_size = csz;
+	toc->decompressed_size = dsz; toc->flags = flg; toc->checksum = sum;
+done:
+	if (entries_obj != Py_None) PyBuffer_Release(&entries);
+	PyBuffer_Release(&header);
+	return (PyObject*)toc;
+}
+
+static void PakToc_dealloc(PakTocObject* self) {
+	for (int c = 0; c < TOC_COLUMNS; ++c) Py_XDECREF(self->columns[c]);
+	PyObject_Free(self);
+}
+
+static PyObject* PakToc_column(PakTocObject* self, void* closure) {
+	int c = (int)(Py_intptr_t)closure;
+	return typed_view(self->columns[c], c <= TOC_HASH_HI ? "I" : "Q");
+}
+
+static PyObject* PakToc_version(PakTocObject* self, void* closure) { return Py_BuildValue("(ii)", self->major, self->minor); }
+
+static Py_ssize_t PakToc_len(PakTocObject* self) { return self->count; }
+
+/* One entry as (hash, offset, compressed_size, decompressed_size, flags, checksum), for UI rows. */
+static PyObject* PakToc_item(PakTocObject* self, Py_ssize_t i) {
+	if (i < 0 || i >= self->count) { PyErr_SetString(PyExc_IndexError, "PAK entry index out of range"); return NULL; }
+	return Py_BuildValue("(KKKKKK)", ((unsigned long long)self->hash_hi[i] << 32) | self->hash_lo[i],
+		self->offset[i], self->compressed_size[i], self->decompressed_size[i], self->flags[i], self->checksum[i]);
+}
+
+static PyGetSetDef PakToc_getset[] = {
+	{"hash_lo", (getter)PakToc_column, NULL, "Lower-case name hashes (uint32)", (void*)TOC_HASH_LO},
+	{"hash_hi", (getter)PakToc_column, NULL, "Upper-case name hashes (uint32)", (void*)TOC_HASH_HI},
+	{"offset", (getter)PakToc_column, NULL, "Entry data offsets (uint64)", (void*)TOC_OFFSET},
+	{"compressed_size", (getter)PakToc_column, NULL, "Stored entry sizes (uint64)", (void*)TOC_COMPRESSED_SIZE},
+	{"decompressed_size", (getter)PakToc_column, NULL, "Decompressed entry sizes (uint64)", (void*)TOC_DECOMPRESSED_SIZE},
+	{"flags", (getter)PakToc_column, NULL, "Entry attribute flags (uint64); low nibble is the compression type", (void*)TOC_FLAGS},
+	{"checksum", (getter)PakToc_column, NULL, "Entry checksums (uint64)", (void*)TOC_CHECKSUM},
+	{"version", (getter)PakToc_version, NULL, "(major, minor) PAK version", NULL},
+	{NULL, NULL, NULL, NULL, NULL}
+};
+
+static PyMemberDef PakToc_members[] = {
+	{"feature", T_INT, offsetof(PakTocObject, feature), READONLY, "PAK header feature flags"},
+	{"fingerprint", T_UINT, offsetof(PakTocObject, fingerprint), READONLY, "PAK header fingerprint field"},
+	{NULL, 0, 0, 0, NULL}
+};
+
+static PySequenceMethods PakToc_as_sequence = {
+	.sq_length = (lenfunc)PakToc_len,
+	.sq_item = (ssizeargfunc)PakToc_item,
+};
+
+static PyTypeObject PakTocType = {
+	PyVarObject_HEAD_INIT(NULL, 0)
+	.tp_name = "fast_pakresolve.PakToc",
+	.tp_doc = "Column view of a PAK table of contents; create with parse_pak_toc().",
+	.tp_basicsize = sizeof(PakTocObject),
+	.tp_flags = Py_TPFLAGS_DEFAULT,
+	.tp_dealloc = (destructor)PakToc_dealloc,
+	.tp_as_sequence = &PakToc_as_sequence,
+	.tp_getset = PakToc_getset,
+	.tp_members = PakToc_members,
+};
+
+/* Backward-shift deletion keeps probe chains intact without tombstones; returns the removed index or -1. */
+static Py_ssize_t table_remove(hash_table* t, unsigned long long key) {
+	if (!t->slots) return -1;
+	Py_ssize_t hole = table_home(t, key);
+	while (t->slots[hole].index >= 0 && t->slots[hole].key != key) hole = (hole + 1) & t->mask;
+	Py_ssize_t removed = t->slots[hole].index;
+	if (removed < 0) return -1;
+	for (Py_ssize_t next = (hole + 1) & t->mask; t->slots[next].index >= 0; next = (next + 1) & t->mask) {
+		Py_ssize_t home = table_home(t, t->slots[next].key);
+		if (((next - home) & t->mask) >= ((next - hole) & t->mask)) { t->slots[hole] = t->slots[next]; hole = next; }
+	}
+	t->slots[hole].index = -1; t->count--;
+	return removed;
+}
+
+static int table_copy(hash_table* dst, const hash_table* src) {
+	if (table_init(dst, src->count) != 0) return -1;
+	for (Py_ssize_t i = 0; src->slots && i <= src->mask; ++i) {
+		if (src->slots[i].index >= 0) table_insert(dst, src->slots[i].key, src->slots[i].index);
+	}
+	return 0;
+}
+
+typedef struct { PyObject_HEAD hash_table table; } PakHashIndexObject;
+static PyTypeObject PakHashIndexType;
+static PyTypeObject UnresolvedHashesType;
+static PyObject* array_type = NULL;
+
+static int hash_from_object(PyObject* o, unsigned long long* out) {
+	if (PyLong_Check(o)) {
+		*out = PyLong_AsUnsignedLongLong(o);
+		return (*out == (unsigned long long)-1 && PyErr_Occurred()) ? -1 : 0;
+	}
+	PyObject* pair = PySequence_Fast(o, "hashes must be ints or (lo, hi) pairs");
+	if (!pair) return -1;
+	if (PySequence_Fast_GET_SIZE(pair) != 2) { Py_DECREF(pair); PyErr_SetString(PyExc_ValueError, "hash pairs must be (lo, hi)"); return -1; }
+	unsigned long lo = PyLong_AsUnsignedLong(PySequence_Fast_GET_ITEM(pair, 0));
+	unsigned long hi = PyLong_AsUnsignedLong(PySequence_Fast_GET_ITEM(pair, 1));
+	Py_DECREF(pair);
+	if (PyErr_Occurred()) return -1;
+	if (lo > 0xFFFFFFFFUL || hi > 0xFFFFFFFFUL) { PyErr_SetString(PyExc_OverflowError, "hash halves must fit in 32 bits"); return -1; }
+	*out = ((unsigned long long)hi << 32) | (unsigned long long)lo; return 0;
+}
+
+static int PakHashIndex_init(PakHashIndexObject* self, PyObject* args, PyObject* kwds) {
+	PyObject* seq;
+	static char* kwlist[] = {"hashes", NULL};
+	if (!PyArg_ParseTupleAndKeywords(args, kwds, "O", kwlist, &seq)) return -1;
+	/* Other threads may be probing the slots without the GIL, so a live table is never replaced. */
+	if (self->table.slots) { PyErr_Format(PyExc_RuntimeError, "%s is already initialized", Py_TYPE(self)->tp_name); return -1; }
+	if (PyObject_TypeCheck(seq, &PakHashIndexType)) {
+		hash_table table;
+		if (table_copy(&table, &((PakHashIndexObject*)seq)->table) != 0) { PyErr_NoMemory(); return -1; }
+		table_free(&self->table); self->table = table; return 0;
+	}
+	if (PyObject_TypeCheck(seq, &PakTocType)) {
+		const PakTocObject* toc = (const PakTocObject*)seq;
+		hash_table table;
+		if (table_init(&table, toc->count) != 0) { PyErr_NoMemory(); return -1; }
+		Py_BEGIN_ALLOW_THREADS
+		for (Py_ssize_t i = 0; i < toc->count; ++i) table_insert(&table, ((unsigned long long)toc->hash_hi[i] << 32) | toc->hash_lo[i], i);
+		Py_END_ALLOW_THREADS
+		table_free(&self->table); self->table = table; return 0;
+	}
+	PyObject* list = PySequence_Fast(seq, "hashes must be a sequence");
+	if (!list) return -1;
+	Py_ssize_t n = PySequence_Fast_GET_SIZE(list);
+	PyObject** items = PySequence_Fast_ITEMS(list);
+	hash_table table;
+	if (table_init(&table, n) != 0) { Py_DECREF(list); PyErr_NoMemory(); return -1; }
+	for (Py_ssize_t i = 0; i < n; ++i) {
+		unsigned long long key;
+		if (hash_from_object(items[i], &key) != 0) { table_free(&table); Py_DECREF(list); return -1; }
+		table_insert(&table, key, i);
+	}
+	Py_DECREF(list);
+	table_free(&self->table); self->table = table; return 0;
+}
+
+static void PakHashIndex_dealloc(PakHashIndexObject* self) {
+	table_free(&self->table);
+	Py_TYPE(self)->tp_free((PyObject*)self);
+}
+
+static Py_ssize_t PakHashIndex_len(PakHashIndexObject* self) { return self->table.count; }
+
+static int PakHashIndex_contains(PakHashIndexObject* self, PyObject* key) {
+	unsigned long long hash;
+	if (!self->table.slots) return 0;
+	if (hash_from_object(key, &hash) != 0) return -1;
+	return table_find(&self->table, hash) >= 0;
+}
+
+static PyObject* PakHashIndex_get(PakHashIndexObject* self, PyObject* args) {
+	PyObject* key; PyObject* fallback = Py_None; unsigned long long hash;
+	if (!PyArg_ParseTuple(args, "O|O", &key, &fallback)) return NULL;
+	if (hash_from_object(key, &hash) != 0) return NULL;
+	Py_ssize_t index = self->table.slots ? table_find(&self->table, hash) : -1;
+	if (index < 0) { Py_INCREF(fallback); return fallback; }
+	return PyLong_FromSsize_t(index);
+}
+
+static inline unsigned long long fmix64(unsigned long long k) {
+	k ^= k >> 33; k *= 0xff51afd7ed558ccdULL; k ^= k >> 33; k *= 0xc4ceb9fe1a85ec53ULL; k ^= k >> 33; return k;
+}
+
+/* Order-independent 64-bit fingerprint of the stored hash set, used to key path index sidecars. */
+static PyObject* PakHashIndex_fingerprint(PakHashIndexObject* self, PyObject* unused) {
+	unsigned long long acc = 0ULL;
+	for (Py_ssize_t i = 0; self->table.slots && i <= self->table.mask; ++i) {
+		if (self->table.slots[i].index >= 0) acc += fmix64(self->table.slots[i].key);
+	}
+	return PyLong_FromUnsignedLongLong(fmix64(acc ^ (unsigned long long)self->table.count));
+}
+
+static PyMethodDef PakHashIndex_methods[] = {
+	{"get", (PyCFunction)PakHashIndex_get, METH_VARARGS, "Return the TOC index for a 64-bit hash or (lo, hi) pair, or default"},
+	{"fingerprint", (PyCFunction)PakHashIndex_fingerprint, METH_NOARGS, "Return an order-independent 64-bit fingerprint of the stored hashes"},
+	{NULL, NULL, 0, NULL}
+};
+
+static PySequenceMethods PakHashIndex_as_sequence = {
+	.sq_length = (lenfunc)PakHashIndex_len,
+	.sq_contains = (objobjproc)PakHashIndex_contains,
+};
+
+static PyTypeObject PakHashIndexType = {
+	PyVarObject_HEAD_INIT(NULL, 0)
+	.tp_name = "fast_pakresolve.PakHashIndex",
+	.tp_doc = "Open-addressing table mapping PAK TOC hashes to TOC indices; build from hashes, a PakToc or another index.",
+	.tp_basicsize = sizeof(PakHashIndexObject),
+	.tp_flags = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE,
+	.tp_new = PyType_GenericNew,
+	.tp_init = (initproc)PakHashIndex_init,
+	.tp_dealloc = (destructor)PakHashIndex_dealloc,
+	.tp_as_sequence = &PakHashIndex_as_sequence,
+	.tp_methods = PakHashIndex_methods,
+};
+
+/* Returns a zero-filled array.array of `count` items; *data points at its storage until it is resized. */
+static PyObject* new_array(const char* typecode, Py_ssize_t count, void** data) {
+	PyObject* unit = PyObject_CallFunction(array_type, "s(i)", typecode, 0);
+	if (!unit) return NULL;
+	PyObject* arr = PySequence_Repeat(unit, count);
+	Py_DECREF(unit);
+	if (!arr) return NULL;
+	Py_buffer view;
+	if (PyObject_GetBuffer(arr, &view, PyBUF_WRITABLE) != 0) { Py_DECREF(arr); return NULL; }
+	*data = view.buf; PyBuffer_Release(&view);
+	return arr;
+}
+
+/* Private view of a caller sequence, for kernels that read item data with the GIL released:
+ * lists are copied to a tuple that holds its own references, so another thread replacing or
+ * dropping list items cannot free data a worker is still hashing. */
+static PyObject* sequence_snapshot(PyObject* seq, const char* message) {
+	if (PyList_Check(seq)) return PyList_AsTuple(seq);
+	return PySequence_Fast(seq, message);
+}
+
 static int get_utf8_ptr(PyObject* u, const uint8_t** buf, Py_ssize_t* len) {
 	const char* s = PyUnicode_AsUTF8AndSize(u, len);
 	if (!s) return -1; *buf = (const uint8_t*)s; return 0;
@@ -38,16 +619,117 @@ static int get_utf16le_bytes(PyObject* u, PyObject** out_b, const uint8_t** buf,
 	*out_b = b; *buf = (const uint8_t*)p; return 0;
 }
 
-static PyObject* resolve_paths_common(PyObject* self, PyObject* args, int encoding_utf16) {
-	PyObject* cache; PyObject* seq;
-	if (!PyArg_ParseTuple(args, "OO", &cache, &seq)) return NULL;
-	PyObject* list = PySequence_Fast(seq, "paths must be a sequence");
+static PyObject* UnresolvedHashes_discard(PakHashIndexObject* self, PyObject* key) {
+	unsigned long long hash;
+	if (hash_from_object(key, &hash) != 0) return NULL;
+	table_remove(&self->table, hash);
+	Py_RETURN_NONE;
+}
+
+typedef struct { unsigned long long key; Py_ssize_t index; } unresolved_row;
+
+static int unresolved_row_cmp(const void* a, const void* b) {
+	Py_ssize_t x = ((const unresolved_row*)a)->index, y = ((const unresolved_row*)b)->index;
+	return x < y ? -1 : (x > y);
+}
+
+/* Remaining (hash, TOC index) columns sorted by TOC index. */
+static PyObject* UnresolvedHashes_items(PakHashIndexObject* self, PyObject* unused) {
+	Py_ssize_t n = self->table.count, k = 0;
+	unresolved_row* rows = (unresolved_row*)PyMem_Malloc((n ? n : 1) * sizeof(unresolved_row));
+	if (!rows) return PyErr_NoMemory();
+	for (Py_ssize_t i = 0; self->table.slots && i <= self->table.mask; ++i) {
+		if (self->table.slots[i].index >= 0) { rows[k].key = self->table.slots[i].key; rows[k].index = self->table.slots[i].index; k++; }
+	}
+	qsort(rows, (size_t)n, sizeof(unresolved_row), unresolved_row_cmp);
+	unsigned long long* hdata; long long* idata;
+	PyObject* hashes = new_array("Q", n, (void**)&hdata);
+	PyObject* indices = hashes ? new_array("q", n, (void**)&idata) : NULL;
+	if (!indices) { Py_XDECREF(hashes); PyMem_Free(rows); return NULL; }
+	for (Py_ssize_t i = 0; i < n; ++i) { hdata[i] = rows[i].key; idata[i] = (long long)rows[i].index; }
+	PyMem_Free(rows);
+	return Py_BuildValue("(NN)", hashes, indices);
+}
+
+static PyMethodDef UnresolvedHashes_methods[] = {
+	{"discard", (PyCFunction)UnresolvedHashes_discard, METH_O, "Remove a 64-bit hash or (lo, hi) pair if present"},
+	{"items", (PyCFunction)UnresolvedHashes_items, METH_NOARGS, "Return the unresolved (hashes, toc_indices) columns sorted by TOC index"},
+	{NULL, NULL, 0, NULL}
+};
+
+static PyTypeObject UnresolvedHashesType = {
+	PyVarObject_HEAD_INIT(NULL, 0)
+	.tp_name = "fast_pakresolve.UnresolvedHashes",
+	.tp_doc = "PakHashIndex that resolve_paths_* prunes as paths match, leaving only unresolved TOC hashes.",
+	.tp_basicsize = sizeof(PakHashIndexObject),
+	.tp_flags = Py_TPFLAGS_DEFAULT,
+	.tp_base = &PakHashIndexType,
+	.tp_methods = UnresolvedHashes_methods,
+};
+
+#define RESOLVE_MIN_CHUNK 4096
+
+/* Per-path codes written by resolve_paths_*(..., status=True). */
+enum { RESOLVE_MISS, RESOLVE_HIT, RESOLVE_ALREADY_SET, RESOLVE_NOT_STRING };
+
+typedef struct {
+	const uint8_t** lbufs; const uint8_t** ubufs;
+	const Py_ssize_t* llens; const Py_ssize_t* ulens;
+	unsigned long long* hashes; const hash_table* table; Py_ssize_t* matches;
+	int encoding_utf16;
+} resolve_job;
+
+static void resolve_range(void* ctx, Py_ssize_t begin, Py_ssize_t end, int worker) {
+	resolve_job* job = (resolve_job*)ctx; const hash_table* table = job->table;
+	unsigned long long started = native_stats_clock(&stats);
+	long long hashed = 0, hits = 0;
+	for (Py_ssize_t i = begin; i < end; ++i) {
+		if (!job->lbufs[i]) { job->hashes[i] = 0ULL; if (table) job->matches[i] = -1; continue; }
+		uint32_t lo, up;
+		/* ASCII paths carry only their original character data (no ubufs entry). */
+		if (!job->ubufs[i]) {
+			murmur3_32_ascii_pair(job->lbufs[i], job->llens[i], job->encoding_utf16, 0xFFFFFFFFU, &lo, &up);
+			hashed += job->llens[i] << (job->encoding_utf16 + 1);
+		} else {
+			lo = murmur3_32(job->lbufs[i], job->llens[i], 0xFFFFFFFFU);
+			up = murmur3_32(job->ubufs[i], job->ulens[i], 0xFFFFFFFFU);
+			hashed += job->llens[i] + job->ulens[i];
+		}
+		job->hashes[i] = ((unsigned long long)up << 32) | (unsigned long long)lo;
+		if (table) { job->matches[i] = table->slots ? table_find(table, job->hashes[i]) : -1; hits += job->matches[i] >= 0; }
+	}
+	if (started) {
+		native_stats_time(&stats, worker, STAT_HASH_NS, started);
+		native_stats_add(&stats, worker, STAT_BYTES_HASHED, hashed);
+		if (table) { native_stats_add(&stats, worker, STAT_INDEX_HITS, hits); native_stats_add(&stats, worker, STAT_INDEX_MISSES, end - begin - hits); }
+	}
+}
+
+static PyObject* resolve_paths_common(PyObject* self, PyObject* args, PyObject* kwds, int encoding_utf16) {
+	PyObject* cache; PyObject* seq; int threads = 1, compact = 0;
+	static char* kwlist[] = {"cache", "paths", "threads", "status", NULL};
+	if (!PyArg_ParseTupleAndKeywords(args, kwds, "OO|ip", kwlist, &cache, &seq, &threads, &compact)) return NULL;
+	if (threads < 0) { PyErr_SetString(PyExc_ValueError, "threads must be >= 0 (0 uses every core)"); return NULL; }
+	threads = native_thread_count(threads);
+	PyObject* list = sequence_snapshot(seq, "paths must be a sequence");
 	if (!list) return NULL;
 	Py_ssize_t n = PySequence_Fast_GET_SIZE(list);
 	PyObject** items = PySequence_Fast_ITEMS(list);
 	PyObject* remaining = PyList_New(0);
 	if (!remaining) { Py_DECREF(list); return NULL; }
 	unsigned long long updated = 0ULL;
+	int use_index = PyObject_TypeCheck(cache, &PakHashIndexType);
+	int prune = PyObject_TypeCheck(cache, &UnresolvedHashesType);
+	PyObject* path_indices = NULL; PyObject* toc_indices = NULL; Py_ssize_t* matches = NULL;
+	/* Compact mode replaces the remaining list and hit columns with one code and TOC index per path. */
+	PyObject* status = NULL; uint8_t* sdata = NULL; long long* tdata = NULL;
+	if (compact) {
+		status = PyByteArray_FromStringAndSize(NULL, n);
+		toc_indices = status ? new_array("q", n, (void**)&tdata) : NULL;
+		if (!toc_indices) { Py_XDECREF(status); Py_DECREF(remaining); Py_DECREF(list); return NULL; }
+		sdata = (uint8_t*)PyByteArray_AS_STRING(status);
+		for (Py_ssize_t i = 0; i < n; ++i) { sdata[i] = RESOLVE_NOT_STRING; tdata[i] = -1; }
+	}
 
 	PyObject** lowers = (PyObject**)PyMem_Calloc(n, sizeof(PyObject*));
 	PyObject** uppers = (PyObject**)PyMem_Calloc(n, sizeof(PyObject*));
@@ -61,77 +743,128 @@ static PyObject* resolve_paths_common(PyObject* self, PyObject* args, int encodi
 	if (!lowers || !uppers || !lbytes || !ubytes || !lbufs || !ubufs || !llens || !ulens || !hashes) {
 		PyMem_Free(lowers); PyMem_Free(uppers); PyMem_Free(lbytes); PyMem_Free(ubytes);
 		PyMem_Free(lbufs); PyMem_Free(ubufs); PyMem_Free(llens); PyMem_Free(ulens); PyMem_Free(hashes);
-		Py_DECREF(remaining); Py_DECREF(list); return PyErr_NoMemory();
+		Py_XDECREF(status); Py_XDECREF(toc_indices); Py_DECREF(remaining); Py_DECREF(list); return PyErr_NoMemory();
 	}
 
+	unsigned long long started = native_stats_clock(&stats);
+	long long ascii = 0, allocated = 0;
 	for (Py_ssize_t i = 0; i < n; ++i) {
 		PyObject* s = items[i];
 		if (!PyUnicode_Check(s)) continue;
+#if PY_VERSION_HEX < 0x030C0000
+		if (PyUnicode_READY(s) < 0) { PyErr_Clear(); continue; }
+#endif
+		if (PyUnicode_IS_ASCII(s)) { lbufs[i] = PyUnicode_1BYTE_DATA(s); llens[i] = PyUnicode_GET_LENGTH(s); ascii++; continue; }
+		allocated += encoding_utf16 ? 4 : 2;
 		lowers[i] = PyObject_CallMethod(s, "lower", NULL);
 		uppers[i] = PyObject_CallMethod(s, "upper", NULL);
-		if (!lowers[i] || !uppers[i]) { Py_XDECREF(lowers[i]); Py_XDECREF(uppers[i]); lowers[i]=uppers[i]=NULL; continue; }
+		if (!lowers[i] || !uppers[i]) { PyErr_Clear(); Py_XDECREF(lowers[i]); Py_XDECREF(uppers[i]); lowers[i]=uppers[i]=NULL; continue; }
 		if (!encoding_utf16) {
 			if (get_utf8_ptr(lowers[i], &lbufs[i], &llens[i]) != 0 || get_utf8_ptr(uppers[i], &ubufs[i], &ulens[i]) != 0) {
-				lbufs[i]=ubufs[i]=NULL; llens[i]=ulens[i]=0;
+				PyErr_Clear(); lbufs[i]=ubufs[i]=NULL; llens[i]=ulens[i]=0;
 			}
 		} else {
 			if (get_utf16le_bytes(lowers[i], &lbytes[i], &lbufs[i], &llens[i]) != 0 || get_utf16le_bytes(uppers[i], &ubytes[i], &ubufs[i], &ulens[i]) != 0) {
-				lbufs[i]=ubufs[i]=NULL; llens[i]=ulens[i]=0;
+				PyErr_Clear(); lbufs[i]=ubufs[i]=NULL; llens[i]=ulens[i]=0;
 			}
 		}
 	}
 
+	native_stats_time(&stats, 0, STAT_FOLD_NS, started);
+	native_stats_add(&stats, 0, STAT_RESOLVE_CALLS, 1);
+	native_stats_add(&stats, 0, STAT_PATHS, n);
+	native_stats_add(&stats, 0, STAT_ASCII_PATHS, ascii);
+	native_stats_add(&stats, 0, STAT_STRINGS_ALLOCATED, allocated);
+
+	if (use_index && !(matches = (Py_ssize_t*)PyMem_Malloc((n ? n : 1) * sizeof(Py_ssize_t)))) { PyErr_NoMemory(); goto cleanup; }
+	resolve_job job = { lbufs, ubufs, llens, ulens, hashes, use_index ? &((PakHashIndexObject*)cache)->table : NULL, matches, encoding_utf16 };
 	Py_BEGIN_ALLOW_THREADS
-	for (Py_ssize_t i = 0; i < n; ++i) {
-		if (!lbufs[i] || !ubufs[i]) { hashes[i] = 0ULL; continue; }
-		uint32_t lo = murmur3_32(lbufs[i], llens[i], 0xFFFFFFFFU);
-		uint32_t up = murmur3_32(ubufs[i], ulens[i], 0xFFFFFFFFU);
-		hashes[i] = ((unsigned long long)up << 32) | (unsigned long long)lo;
-	}
+	native_parallel_for(n, threads, RESOLVE_MIN_CHUNK, resolve_range, &job);
 	Py_END_ALLOW_THREADS
+	started = native_stats_clock(&stats);
+
+	if (use_index) {
+		Py_ssize_t hits = 0;
+		for (Py_ssize_t i = 0; i < n; ++i) {
+			/* Pruning runs in path order, so the first path for a hash wins and later duplicates are dropped. */
+			if (matches[i] >= 0 && prune && table_remove(&((PakHashIndexObject*)cache)->table, hashes[i]) < 0) matches[i] = -2;
+			if (compact) {
+				if (!lbufs[i]) continue;
+				sdata[i] = matches[i] >= 0 ? RESOLVE_HIT : matches[i] == -2 ? RESOLVE_ALREADY_SET : RESOLVE_MISS;
+				if (matches[i] >= 0) { tdata[i] = (long long)matches[i]; updated++; }
+				continue;
+			}
+			if (matches[i] >= 0) { hits++; continue; }
+			if (matches[i] == -1 && lbufs[i] && PyList_Append(remaining, items[i]) != 0) goto cleanup;
+		}
+		if (compact) goto cleanup;
+		long long* pdata;
+		path_indices = new_array("q", hits, (void**)&pdata);
+		toc_indices = path_indices ? new_array("q", hits, (void**)&tdata) : NULL;
+		if (!toc_indices) goto cleanup;
+		for (Py_ssize_t i = 0, k = 0; i < n; ++i) {
+			if (matches[i] < 0) continue;
+			pdata[k] = (long long)i; tdata[k] = (long long)matches[i]; k++;
+		}
+		goto cleanup;
+	}
 
 	for (Py_ssize_t i = 0; i < n; ++i) {
-		if (!hashes[i]) continue;
+		if (!lbufs[i]) continue;
 		PyObject* key = PyLong_FromUnsignedLongLong(hashes[i]);
+		if (!key) goto cleanup;
 		PyObject* val = PyDict_GetItemWithError(cache, key);
 		Py_DECREF(key);
+		native_stats_add(&stats, 0, val ? STAT_DICT_HITS : STAT_DICT_MISSES, 1);
 		if (!val) {
 			if (PyErr_Occurred()) {
 				goto cleanup;
 			}
-			if (!encoding_utf16) {
-				PyObject* s = items[i];
-				PyList_Append(remaining, s);
-			}
+			if (compact) sdata[i] = RESOLVE_MISS;
+			else if (PyList_Append(remaining, items[i]) != 0) goto cleanup;
 			continue;
 		}
+		if (compact) {
+			/* Cache values are (toc_index, entry) tuples. */
+			PyObject* index = PyTuple_Check(val) && PyTuple_GET_SIZE(val) > 0 ? PyTuple_GET_ITEM(val, 0) : NULL;
+			sdata[i] = RESOLVE_ALREADY_SET;
+			if (index && PyLong_Check(index)) {
+				tdata[i] = PyLong_AsLongLong(index);
+				if (tdata[i] == -1 && PyErr_Occurred()) { PyErr_Clear(); tdata[i] = -1; }
+			}
+		}
 		PyObject* entry = PyTuple_GetItem(val, 1);
 		if (entry) {
 			PyObject* cur = PyObject_GetAttrString(entry, "path");
 			if (cur == Py_None || cur == NULL) {
 				PyObject* s = items[i];
-				if (PyObject_SetAttrString(entry, "path", s) == 0) { updated++; }
+				if (PyObject_SetAttrString(entry, "path", s) == 0) {
+					updated++;
+					if (compact) sdata[i] = RESOLVE_HIT;
+				}
 			}
 			Py_XDECREF(cur);
 		}
 	}
 
 cleanup:
+	native_stats_time(&stats, 0, STAT_COLLECT_NS, started);
+	if (!use_index) native_stats_add(&stats, 0, STAT_PATHS_SET, (long long)updated);
 	for (Py_ssize_t i = 0; i < n; ++i) {
 		Py_XDECREF(lbytes[i]); Py_XDECREF(ubytes[i]);
 		Py_XDECREF(lowers[i]); Py_XDECREF(uppers[i]);
 	}
 	PyMem_Free(lowers); PyMem_Free(uppers); PyMem_Free(lbytes); PyMem_Free(ubytes);
-	PyMem_Free(lbufs); PyMem_Free(ubufs); PyMem_Free(llens); PyMem_Free(ulens); PyMem_Free(hashes);
-	{
-		PyObject* result = Py_BuildValue("(NK)", remaining, (unsigned long long)updated);
-		Py_DECREF(list);
-		return result;
-	}
+	PyMem_Free(lbufs); PyMem_Free(ubufs); PyMem_Free(llens); PyMem_Free(ulens); PyMem_Free(hashes); PyMem_Free(matches);
+	Py_DECREF(list);
+	if (PyErr_Occurred()) { Py_DECREF(remaining); Py_XDECREF(path_indices); Py_XDECREF(toc_indices); Py_XDECREF(status); return NULL; }
+	if (compact) { Py_DECREF(remaining); return Py_BuildValue("(NNK)", status, toc_indices, (unsigned long long)updated); }
+	if (use_index) return Py_BuildValue("(NNN)", remaining, path_indices, toc_indices);
+	return Py_BuildValue("(NK)", remaining, (unsigned long long)updated);
 }
 
-static PyObject* resolve_paths_utf8(PyObject* self, PyObject* args) { return resolve_paths_common(self, args, 0); }
-static PyObject* resolve_paths_utf16le(PyObject* self, PyObject* args) { return resolve_paths_common(self, args, 1); }
+static PyObject* resolve_paths_utf8(PyObject* self, PyObject* args, PyObject* kwds) { return resolve_paths_common(self, args, kwds, 0); }
+static PyObject* resolve_paths_utf16le(PyObject* self, PyObject* args, PyObject* kwds) { return resolve_paths_common(self, args, kwds, 1); }
 
 static PyObject* murmur3_hash(PyObject* self, PyObject* args) {
 	const char* data;
@@ -143,10 +876,867 @@ static PyObject* murmur3_hash(PyObject* self, PyObject* args) {
 	return PyLong_FromUnsignedLong(hash);
 }
 
+/* Candidate generation: every dirs x stems x exts x versions combination is assembled from
+ * pre-folded UTF-16LE component bytes in a per-worker buffer, hashed and probed, and only hits
+ * become Python strings. Folding components separately matches folding the joined path except
+ * for context-dependent mappings such as a word-final sigma. */
+#define PROBE_PARTS 4
+#define PROBE_MIN_CHUNK 65536
+
+typedef struct {
+	Py_ssize_t count;
+	const Py_ssize_t* lower_off; const Py_ssize_t* upper_off;
+	const Py_ssize_t* lower_len; const Py_ssize_t* upper_len;
+} probe_part;
+
+typedef struct { long long combo; Py_ssize_t toc_index; unsigned long long hash; } probe_hit;
+
+typedef struct {
+	probe_part parts[PROBE_PARTS]; const uint8_t* pool; Py_ssize_t max_len;
+	const hash_table* table;
+	probe_hit* hits[NATIVE_MAX_THREADS]; Py_ssize_t hit_count[NATIVE_MAX_THREADS]; int failed;
+} probe_job;
+
+static void probe_range(void* ctx, Py_ssize_t begin, Py_ssize_t end, int worker) {
+	probe_job* job = (probe_job*)ctx;
+	uint8_t* lower = (uint8_t*)PyMem_RawMalloc((size_t)job->max_len * 2 + 2);
+	uint8_t* upper = lower ? lower + job->max_len + 1 : NULL;
+	probe_hit* hits = NULL; Py_ssize_t count = 0, cap = 0;
+	if (!lower) { job->failed = 1; return; }
+	Py_ssize_t digit[PROBE_PARTS]; long long rest = (long long)begin;
+	for (int p = PROBE_PARTS - 1; p >= 0; --p) { digit[p] = (Py_ssize_t)(rest % job->parts[p].count); rest /= job->parts[p].count; }
+	for (Py_ssize_t combo = begin; combo < end; ++combo) {
+		Py_ssize_t llen = 0, ulen = 0;
+		for (int p = 0; p < PROBE_PARTS; ++p) {
+			const probe_part* part = &job->parts[p]; Py_ssize_t d = digit[p];
+			memcpy(lower + llen, job->pool + part->lower_off[d], (size_t)part->lower_len[d]); llen += part->lower_len[d];
+			memcpy(upper + ulen, job->pool + part->upper_off[d], (size_t)part->upper_len[d]); ulen += part->upper_len[d];
+		}
+		unsigned long long hash = ((unsigned long long)murmur3_32(upper, ulen, 0xFFFFFFFFU) << 32) | murmur3_32(lower, llen, 0xFFFFFFFFU);
+		Py_ssize_t found = table_find(job->table, hash);
+		if (found >= 0) {
+			if (count == cap) {
+				cap = cap ? cap * 2 : 64;
+				probe_hit* grown = (probe_hit*)PyMem_RawRealloc(hits, (size_t)cap * sizeof(probe_hit));
+				if (!grown) { job->failed = 1; break; }
+				hits = grown;
+			}
+			hits[count].combo = (long long)combo; hits[count].toc_index = found; hits[count].hash = hash; count++;
+		}
+		for (int p = PROBE_PARTS - 1; p >= 0 && ++digit[p] == job->parts[p].count; --p) digit[p] = 0;
+	}
+	PyMem_RawFree(lower);
+	job->hits[worker] = hits; job->hit_count[worker] = count;
+	native_stats_add(&stats, worker, STAT_PROBE_HITS, count);
+}
+
+/* Folds one component sequence into job pool offsets; None stands for a single empty component. */
+static int probe_prepare_part(PyObject* seq, PyObject** list_out, probe_part* part, Py_ssize_t** arrays, PyObject* pool, Py_ssize_t* max_len) {
+	PyObject* list = seq == Py_None ? Py_BuildValue("[s]", "") : PySequence_List(seq);
+	if (!list) return -1;
+	*list_out = list;
+	Py_ssize_t n = PyList_GET_SIZE(list);
+	part->count = n;
+	if (!(arrays[0] = (Py_ssize_t*)PyMem_Malloc((n ? n : 1) * 4 * sizeof(Py_ssize_t)))) { PyErr_NoMemory(); return -1; }
+	Py_ssize_t* lower_off = arrays[0]; Py_ssize_t* upper_off = lower_off + n; Py_ssize_t* lower_len = upper_off + n; Py_ssize_t* upper_len = lower_len + n;
+	part->lower_off = lower_off; part->upper_off = upper_off; part->lower_len = lower_len; part->upper_len = upper_len;
+	Py_ssize_t longest = 0;
+	for (Py_ssize_t i = 0; i < n; ++i) {
+		PyObject* item = PyList_GET_ITEM(list, i);
+		if (!PyUnicode_Check(item)) { PyErr_SetString(PyExc_TypeError, "pattern components must be str"); return -1; }
+		for (int upper = 0; upper < 2; ++upper) {
+			PyObject* folded = PyObject_CallMethod(item, upper ? "upper" : "lower", NULL);
+			PyObject* encoded = folded ? PyUnicode_AsEncodedString(folded, "utf-16le", "strict") : NULL;
+			Py_XDECREF(folded);
+			if (!encoded) return -1;
+			Py_ssize_t start = PyByteArray_GET_SIZE(pool), len = PyBytes_GET_SIZE(encoded);
+			int ok = PyByteArray_Resize(pool, start + len) == 0;
+			if (ok) memcpy(PyByteArray_AS_STRING(pool) + start, PyBytes_AS_STRING(encoded), (size_t)len);
+			Py_DECREF(encoded);
+			if (!ok) return -1;
+			(upper ? upper_off : lower_off)[i] = start; (upper ? upper_len : lower_len)[i] = len;
+			if (len > longest) longest = len;
+		}
+	}
+	*max_len += longest;
+	return 0;
+}
+
+static PyObject* probe_patterns(PyObject* self, PyObject* args, PyObject* kwds) {
+	PyObject* seqs[PROBE_PARTS]; PyObject* index; int threads = 0;
+	static char* kwlist[] = {"dirs", "stems", "exts", "versions", "index", "threads", NULL};
+	if (!PyArg_ParseTupleAndKeywords(args, kwds, "OOOOO!|i", kwlist, &seqs[0], &seqs[1], &seqs[2], &seqs[3], &PakHashIndexType, &index, &threads)) return NULL;
+	if (threads < 0) { PyErr_SetString(PyExc_ValueError, "threads must be >= 0 (0 uses every core)"); return NULL; }
+	threads = native_thread_count(threads);
+	probe_job job; memset(&job, 0, sizeof(job));
+	PyObject* lists[PROBE_PARTS] = {NULL, NULL, NULL, NULL}; Py_ssize_t* arrays[PROBE_PARTS] = {NULL, NULL, NULL, NULL};
+	PyObject* result = NULL;
+	PyObject* pool = PyByteArray_FromStringAndSize(NULL, 0);
+	if (!pool) return NULL;
+	long long total = 1;
+	for (int p = 0; p < PROBE_PARTS; ++p) {
+		if (probe_prepare_part(seqs[p], &lists[p], &job.parts[p], &arrays[p], pool, &job.max_len) != 0) goto done;
+		if (job.parts[p].count && total > PY_SSIZE_T_MAX / job.parts[p].count) { PyErr_SetString(PyExc_OverflowError, "too many pattern combinations"); goto done; }
+		total *= job.parts[p].count;
+	}
+	job.pool = (const uint8_t*)PyByteArray_AS_STRING(pool);
+	job.table = &((PakHashIndexObject*)index)->table;
+	int prune = PyObject_TypeCheck(index, &UnresolvedHashesType);
+	if (total && job.table->slots) {
+		unsigned long long started = native_stats_clock(&stats);
+		Py_BEGIN_ALLOW_THREADS
+		native_parallel_for((Py_ssize_t)total, threads, PROBE_MIN_CHUNK, probe_range, &job);
+		Py_END_ALLOW_THREADS
+		native_stats_time(&stats, 0, STAT_PROBE_NS, started);
+		native_stats_add(&stats, 0, STAT_PROBE_CANDIDATES, total);
+	}
+	if (job.failed) { PyErr_NoMemory(); goto done; }
+	if (!(result = PyList_New(0))) goto done;
+	/* Workers own ascending combination ranges, so concatenating their hits keeps combination order. */
+	for (int w = 0; w < NATIVE_MAX_THREADS; ++w) {
+		for (Py_ssize_t h = 0; h < job.hit_count[w]; ++h) {
+			const probe_hit* hit = &job.hits[w][h];
+			if (prune && table_remove(&((PakHashIndexObject*)index)->table, hit->hash) < 0) continue;
+			long long rest = hit->combo; Py_ssize_t digit[PROBE_PARTS];
+			for (int p = PROBE_PARTS - 1; p >= 0; --p) { digit[p] = (Py_ssize_t)(rest % job.parts[p].count); rest /= job.parts[p].count; }
+			PyObject* path = PyUnicode_FromStringAndSize(NULL, 0);
+			for (int p = 0; path && p < PROBE_PARTS; ++p) PyUnicode_Append(&path, PyList_GET_ITEM(lists[p], digit[p]));
+			PyObject* row = path ? Py_BuildValue("(Nn)", path, hit->toc_index) : NULL;
+			if (!row || PyList_Append(result, row) != 0) { Py_XDECREF(row); Py_CLEAR(result); goto done; }
+			Py_DECREF(row);
+		}
+	}
+done:
+	for (int w = 0; w < NATIVE_MAX_THREADS; ++w) PyMem_RawFree(job.hits[w]);
+	for (int p = 0; p < PROBE_PARTS; ++p) { Py_XDECREF(lists[p]); PyMem_Free(arrays[p]); }
+	Py_DECREF(pool);
+	return result;
+}
+
+/* Fused harvesting: the native string scan runs over a binary, runs that look like asset paths
+ * ('/' plus an extension in the last component) are case-folded and hashed straight from the
+ * source bytes, and only index hits become Python strings. Paths with non-ASCII characters need full
+ * Unicode case mapping, so they are hashed with str.lower()/str.upper() in the GIL phase instead. */
+#define CANDIDATE_SKIP -1
+#define CANDIDATE_DEFER -2
+
+typedef struct { Py_ssize_t toc_index; unsigned long long hash; } scan_match;
+
+typedef struct {
+	scan_job scan;
+	const hash_table* table; const hash_table* extensions;
+	scan_match* matches[NATIVE_MAX_THREADS][3];
+} scan_resolve_job;
+
+static inline unsigned long long extension_key(const uint8_t* s, Py_ssize_t n) {
+	return ((unsigned long long)n << 32) | murmur3_32(s, n, 0xFFFFFFFFU);
+}
+
+/* Classifies one span; ascii receives the characters when they are all ASCII. */
+static Py_ssize_t classify_candidate(const scan_resolve_job* job, const scan_span* span, int utf8, uint8_t* ascii, unsigned long long* hash) {
+	const uint8_t* data = job->scan.data + span->offset;
+	Py_ssize_t chars = utf8 ? span->length : span->length / 2, last_slash = -1;
+	int non_ascii = 0;
+	for (Py_ssize_t i = 0; i < chars; ++i) {
+		unsigned int c = utf8 ? data[i] : (unsigned int)data[2 * i] | ((unsigned int)data[2 * i + 1] << 8);
+		if (c >= 0x80) { non_ascii = 1; c = 0x80; }
+		if (c == '/') last_slash = i;
+		ascii[i] = (uint8_t)c;
+	}
+	if (last_slash < 0) return CANDIDATE_SKIP;
+	Py_ssize_t dot = last_slash + 1;
+	while (dot < chars && ascii[dot] != '.') dot++;
+	Py_ssize_t ext_end = dot + 1;
+	while (ext_end < chars && ascii[ext_end] != '.') ext_end++;
+	if (dot + 1 >= ext_end) return CANDIDATE_SKIP;
+	if (job->extensions) {
+		uint8_t ext[64]; Py_ssize_t n = ext_end - dot - 1;
+		if (n > (Py_ssize_t)sizeof(ext)) return CANDIDATE_SKIP;
+		for (Py_ssize_t i = 0; i < n; ++i) { ext[i] = ascii_lower(ascii[dot + 1 + i]); if (ext[i] >= 0x80) return CANDIDATE_SKIP; }
+		if (table_find(job->extensions, extension_key(ext, n)) < 0) return CANDIDATE_SKIP;
+	}
+	if (non_ascii) return CANDIDATE_DEFER;
+	uint32_t lo, up;
+	murmur3_32_ascii_pair(ascii, chars, 1, 0xFFFFFFFFU, &lo, &up);
+	*hash = ((unsigned long long)up << 32) | lo;
+	Py_ssize_t found = job->table->slots ? table_find(job->table, *hash) : -1;
+	return found >= 0 ? found : CANDIDATE_SKIP;
+}
+
+static void scan_resolve_range(void* ctx, Py_ssize_t begin, Py_ssize_t end, int worker) {
+	scan_resolve_job* job = (scan_resolve_job*)ctx;
+	scan_range(&job->scan, begin, end, worker);
+	if (job->scan.failed) return;
+	uint8_t* ascii = NULL; Py_ssize_t capacity = 0;
+	for (int s = 0; s < 3 && !job->scan.failed; ++s) {
+		const span_list* list = &job->scan.spans[worker][s];
+		scan_match* matches = (scan_match*)PyMem_RawMalloc((size_t)(list->count ? list->count : 1) * sizeof(scan_match));
+		if (!(job->matches[worker][s] = matches)) { job->scan.failed = 1; break; }
+		for (Py_ssize_t i = 0; i < list->count; ++i) {
+			Py_ssize_t chars = s == SCAN_UTF8 ? list->items[i].length : list->items[i].length / 2;
+			if (chars > capacity) {
+				uint8_t* grown = (uint8_t*)PyMem_RawRealloc(ascii, (size_t)chars);
+				if (!grown) { job->scan.failed = 1; break; }
+				ascii = grown; capacity = chars;
+			}
+			matches[i].hash = 0ULL;
+			matches[i].toc_index = classify_candidate(job, &list->items[i], s == SCAN_UTF8, ascii, &matches[i].hash);
+		}
+	}
+	PyMem_RawFree(ascii);
+}
+
+/* Hashes a deferred non-ASCII candidate like resolve_paths_utf16le; returns 0 when it cannot be encoded. */
+static int hash_deferred_candidate(PyObject* path, unsigned long long* hash) {
+	PyObject* lower = PyObject_CallMethod(path, "lower", NULL);
+	PyObject* upper = lower ? PyObject_CallMethod(path, "upper", NULL) : NULL;
+	PyObject* lbytes = upper ? PyUnicode_AsEncodedString(lower, "utf-16le", "strict") : NULL;
+	PyObject* ubytes = lbytes ? PyUnicode_AsEncodedString(upper, "utf-16le", "strict") : NULL;
+	int ok = ubytes != NULL;
+	if (ok) {
+		*hash = ((unsigned long long)murmur3_32((const uint8_t*)PyBytes_AS_STRING(ubytes), PyBytes_GET_SIZE(ubytes), 0xFFFFFFFFU) << 32)
+			| murmur3_32((const uint8_t*)PyBytes_AS_STRING(lbytes), PyBytes_GET_SIZE(lbytes), 0xFFFFFFFFU);
+	} else {
+		PyErr_Clear();
+	}
+	Py_XDECREF(lower); Py_XDECREF(upper); Py_XDECREF(lbytes); Py_XDECREF(ubytes);
+	return ok;
+}
+
+static PyObject* scan_resolve(PyObject* self, PyObject* args, PyObject* kwds) {
+	PyObject* source; PyObject* index; PyObject* extensions = Py_None; Py_ssize_t min_length = 5; int threads = 0;
+	static char* kwlist[] = {"source", "index", "min_length", "extensions", "threads", NULL};
+	if (!PyArg_ParseTupleAndKeywords(args, kwds, "OO!|nOi", kwlist, &source, &PakHashIndexType, &index, &min_length, &extensions, &threads)) return NULL;
+	if (min_length <= 0) { PyErr_SetString(PyExc_ValueError, "min_length must be positive"); return NULL; }
+	if (min_length > PY_SSIZE_T_MAX / 2) { PyErr_SetString(PyExc_OverflowError, "min_length is too large"); return NULL; }
+	if (threads < 0) { PyErr_SetString(PyExc_ValueError, "threads must be >= 0 (0 uses every core)"); return NULL; }
+	hash_table ext_table = {NULL, -1, 0, 0}, seen = {NULL, -1, 0, 0};
+	scan_resolve_job* job = NULL; PyObject* result = NULL; Py_buffer view; view.obj = NULL;
+	hash_table* table = &((PakHashIndexObject*)index)->table;
+	int prune = PyObject_TypeCheck(index, &UnresolvedHashesType);
+
+	if (extensions != Py_None) {
+		PyObject* list = PySequence_List(extensions);
+		if (!list) return NULL;
+		Py_ssize_t n = PyList_GET_SIZE(list);
+		if (table_init(&ext_table, n) != 0) { Py_DECREF(list); return PyErr_NoMemory(); }
+		for (Py_ssize_t i = 0; i < n; ++i) {
+			PyObject* item = PyList_GET_ITEM(list, i); Py_ssize_t len; const char* ext;
+			if (!PyUnicode_Check(item) || !(ext = PyUnicode_AsUTF8AndSize(item, &len))) {
+				if (!PyErr_Occurred()) PyErr_SetString(PyExc_TypeError, "extensions must be str");
+				Py_DECREF(list); goto done;
+			}
+			if (len && ext[0] == '.') { ext++; len--; }
+			uint8_t folded[64];
+			if (len > (Py_ssize_t)sizeof(folded)) continue;
+			for (Py_ssize_t k = 0; k < len; ++k) folded[k] = ascii_lower((uint8_t)ext[k]);
+			table_insert(&ext_table, extension_key(folded, len), i);
+		}
+		Py_DECREF(list);
+	}
+	if (PyObject_GetBuffer(source, &view, PyBUF_CONTIG_RO) != 0) { view.obj = NULL; goto done; }
+	if (!(job = (scan_resolve_job*)PyMem_Calloc(1, sizeof(scan_resolve_job)))) { PyErr_NoMemory(); goto done; }
+	job->scan.data = (const uint8_t*)view.buf; job->scan.length = view.len; job->scan.min_length = min_length;
+	job->scan.masks = scan_select_masks();
+	job->scan.workers = native_worker_count(view.len, native_thread_count(threads), SCAN_MIN_CHUNK);
+	job->table = table; job->extensions = ext_table.slots ? &ext_table : NULL;
+	unsigned long long started = native_stats_clock(&stats);
+	Py_BEGIN_ALLOW_THREADS
+	native_parallel_for(view.len ? view.len : 1, job->scan.workers, SCAN_MIN_CHUNK, scan_resolve_range, job);
+	Py_END_ALLOW_THREADS
+	native_stats_time(&stats, 0, STAT_SCAN_NS, started);
+	native_stats_add(&stats, 0, STAT_SCAN_BYTES, view.len);
+	if (job->scan.failed) { PyErr_NoMemory(); goto done; }
+	/* Without pruning, a path repeated in the binary is still reported once. */
+	if (!prune && table_init(&seen, table->count) != 0) { PyErr_NoMemory(); goto done; }
+	if (!(result = PyList_New(0))) goto done;
+	for (int s = 0; s < 3; ++s) {
+		for (int w = 0; w < job->scan.workers; ++w) {
+			const span_list* list = &job->scan.spans[w][s];
+			for (Py_ssize_t i = 0; i < list->count; ++i) {
+				scan_match match = job->matches[w][s][i];
+				if (match.toc_index == CANDIDATE_SKIP) continue;
+				const scan_span* span = &list->items[i];
+				const char* data = (const char*)view.buf + span->offset;
+				int byteorder = -1;
+				PyObject* path = s == SCAN_UTF8 ? PyUnicode_DecodeUTF8(data, span->length, "strict") : PyUnicode_DecodeUTF16(data, span->length, "strict", &byteorder);
+				if (!path) { Py_CLEAR(result); goto done; }
+				if (match.toc_index == CANDIDATE_DEFER) {
+					match.toc_index = hash_deferred_candidate(path, &match.hash) && table->slots ? table_find(table, match.hash) : -1;
+				}
+				int fresh = match.toc_index >= 0;
+				if (fresh && prune) fresh = table_remove(table, match.hash) >= 0;
+				else if (fresh) { fresh = table_find(&seen, match.hash) < 0; if (fresh) table_insert(&seen, match.hash, match.toc_index); }
+				PyObject* row = fresh ? Py_BuildValue("(Nn)", path, match.toc_index) : NULL;
+				if (!fresh) { Py_DECREF(path); continue; }
+				if (!row || PyList_Append(result, row) != 0) { Py_XDECREF(row); Py_CLEAR(result); goto done; }
+				Py_DECREF(row);
+			}
+		}
+	}
+done:
+	if (result) native_stats_add(&stats, 0, STAT_SCAN_HITS, PyList_GET_SIZE(result));
+	if (job) {
+		for (int w = 0; w < job->scan.workers; ++w) for (int s = 0; s < 3; ++s) PyMem_RawFree(job->matches[w][s]);
+		scan_job_free(&job->scan); /* scan is the first member, so this releases the whole job */
+	}
+	if (view.obj) PyBuffer_Release(&view);
+	table_free(&ext_table); table_free(&seen);
+	return result;
+}
+
+typedef struct { const uint8_t* const* bufs; const Py_ssize_t* lens; uint32_t seed; uint32_t* out; } hash_many_job;
+
+static void hash_many_range(void* ctx, Py_ssize_t begin, Py_ssize_t end, int worker) {
+	hash_many_job* job = (hash_many_job*)ctx;
+	unsigned long long started = native_stats_clock(&stats);
+	murmur3_32_many(job->bufs + begin, job->lens + begin, end - begin, job->seed, job->out + begin);
+	if (started) {
+		long long hashed = 0;
+		for (Py_ssize_t i = begin; i < end; ++i) hashed += job->lens[i];
+		native_stats_time(&stats, worker, STAT_HASH_NS, started);
+		native_stats_add(&stats, worker, STAT_BYTES_HASHED, hashed);
+	}
+}
+
+static PyObject* murmur3_hash_many(PyObject* self, PyObject* args, PyObject* kwds) {
+	PyObject* seq; unsigned long seed = 0xFFFFFFFFUL; int threads = 1;
+	static char* kwlist[] = {"buffers", "seed", "threads", NULL};
+	if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|ki", kwlist, &seq, &seed, &threads)) return NULL;
+	if (threads < 0) { PyErr_SetString(PyExc_ValueError, "threads must be >= 0 (0 uses every core)"); return NULL; }
+	threads = native_thread_count(threads);
+	PyObject* list = PySequence_Fast(seq, "buffers must be a sequence");
+	if (!list) return NULL;
+	Py_ssize_t n = PySequence_Fast_GET_SIZE(list);
+	PyObject** items = PySequence_Fast_ITEMS(list);
+	Py_buffer* views = (Py_buffer*)PyMem_Calloc(n ? n : 1, sizeof(Py_buffer));
+	const uint8_t** bufs = (const uint8_t**)PyMem_Calloc(n ? n : 1, sizeof(uint8_t*));
+	Py_ssize_t* lens = (Py_ssize_t*)PyMem_Calloc(n ? n : 1, sizeof(Py_ssize_t));
+	PyObject* result = NULL; Py_ssize_t acquired = 0; uint32_t* out;
+	if (!views || !bufs || !lens) { PyErr_NoMemory(); goto done; }
+	for (; acquired < n; ++acquired) {
+		if (PyObject_GetBuffer(items[acquired], &views[acquired], PyBUF_SIMPLE) != 0) goto done;
+		bufs[acquired] = (const uint8_t*)views[acquired].buf; lens[acquired] = views[acquired].len;
+	}
+	result = new_array("I", n, (void**)&out);
+	if (!result) goto done;
+	hash_many_job job = { bufs, lens, (uint32_t)seed, out };
+	Py_BEGIN_ALLOW_THREADS
+	native_parallel_for(n, threads, RESOLVE_MIN_CHUNK, hash_many_range, &job);
+	Py_END_ALLOW_THREADS
+done:
+	for (Py_ssize_t i = 0; i < acquired; ++i) PyBuffer_Release(&views[i]);
+	PyMem_Free(views); PyMem_Free(bufs); PyMem_Free(lens);
+	Py_DECREF(list);
+	return result;
+}
+
+/* Bulk extraction: selected entries are claimed in file-offset order by a pool of native workers,
+ * each with its own positional PAK handle. Stored and deflate entries stream through a fixed-size
+ * buffer; zstd entries are read whole and their output streamed. zlib/zstandard release the GIL
+ * while they decompress, so workers only hold it long enough to make each call. */
+#define EXTRACT_COPY_CHUNK ((size_t)1 << 20)
+#define EXTRACT_PROGRESS_NS 100000000ULL
+
+enum { EXTRACT_OK, EXTRACT_PENDING, EXTRACT_READ_ERROR, EXTRACT_WRITE_ERROR, EXTRACT_UNSUPPORTED, EXTRACT_DECOMPRESS_ERROR };
+
+typedef struct {
+	const PakTocObject* toc; const native_path_char* pak_path;
+	native_path_char** outputs; const Py_ssize_t* entries; const Py_ssize_t* order; Py_ssize_t count;
+	unsigned char* status;
+	volatile long long next; volatile long long done; volatile long long bytes_written; volatile long long cancelled;
+	PyObject* progress; PyObject* zlib_decompressobj; PyObject* zstd_module;
+	PyObject* error_type; PyObject* error_value; PyObject* error_tb;
+	unsigned long long last_report;
+} extract_job;
+
+typedef struct { unsigned long long offset; Py_ssize_t item; } extract_row;
+
+static int extract_row_cmp(const void* a, const void* b) {
+	const extract_row* x = (const extract_row*)a; const extract_row* y = (const extract_row*)b;
+	if (x->offset != y->offset) return x->offset < y->offset ? -1 : 1;
+	return x->item < y->item ? -1 : (x->item > y->item);
+}
+
+static int ensure_capacity(uint8_t** buf, size_t* cap, size_t need) {
+	if (*cap >= need) return 0;
+	uint8_t* grown = (uint8_t*)PyMem_RawRealloc(*buf, need ? need : 1);
+	if (!grown) return -1;
+	*buf = grown; *cap = need; return 0;
+}
+
+/* Appends one decompressed piece; output past the TOC's decompressed size is a corrupt entry. */
+static int extract_write(FILE* out, PyObject* piece, unsigned long long dsize, unsigned long long* written) {
+	size_t len = (size_t)PyBytes_GET_SIZE(piece);
+	if (len > dsize - *written) return EXTRACT_DECOMPRESS_ERROR;
+	if (len && fwrite(PyBytes_AS_STRING(piece), 1, len, out) != len) return EXTRACT_WRITE_ERROR;
+	*written += len;
+	return EXTRACT_OK;
+}
+
+/* Runs on a worker without the GIL; takes it only around the decompressor calls. Output is pulled
+ * in EXTRACT_COPY_CHUNK pieces and must total exactly `dsize`. Deflate input is read in pieces too;
+ * a zstd entry's compressed bytes are read whole, so a worker holds at most one compressed zstd
+ * entry plus one output chunk. */
+static int extract_compressed(extract_job* job, native_rfile* pak, int compression, unsigned long long offset, unsigned long long size, unsigned long long dsize, uint8_t** buf, size_t* cap, PyObject** zstd_ctx, FILE* out, unsigned long long* written) {
+	int status = EXTRACT_OK, finished = 0;
+	int zstd = compression == PAK_COMPRESSION_ZSTD;
+	size_t need = zstd || size < EXTRACT_COPY_CHUNK ? (size_t)size : EXTRACT_COPY_CHUNK;
+	if (ensure_capacity(buf, cap, need) != 0) return EXTRACT_READ_ERROR;
+	if (zstd && native_pread(pak, *buf, (size_t)size, offset) != 0) return EXTRACT_READ_ERROR;
+	PyGILState_STATE gil = PyGILState_Ensure();
+	PyObject* view = NULL; PyObject* stream = NULL; PyObject* input = NULL;
+	if (!zstd) {
+		stream = PyObject_CallFunction(job->zlib_decompressobj, "i", -15);
+	} else {
+		if (!*zstd_ctx) *zstd_ctx = PyObject_CallMethod(job->zstd_module, "ZstdDecompressor", NULL);
+		view = *zstd_ctx ? PyMemoryView_FromMemory((char*)*buf, (Py_ssize_t)size, PyBUF_READ) : NULL;
+		if (view) stream = PyObject_CallMethod(*zstd_ctx, "stream_reader", "O", view);
+	}
+	PyGILState_Release(gil);
+	if (!stream) status = EXTRACT_DECOMPRESS_ERROR;
+	for (unsigned long long pos = 0; status == EXTRACT_OK && !finished; ) {
+		if (!zstd && !input && pos < size) {
+			size_t chunk = size - pos < EXTRACT_COPY_CHUNK ? (size_t)(size - pos) : EXTRACT_COPY_CHUNK;
+			if (native_pread(pak, *buf, chunk, offset + pos) != 0) { status = EXTRACT_READ_ERROR; break; }
+			pos += chunk;
+			gil = PyGILState_Ensure();
+			input = PyBytes_FromStringAndSize((const char*)*buf, (Py_ssize_t)chunk);
+			PyGILState_Release(gil);
+			if (!input) { status = EXTRACT_DECOMPRESS_ERROR; break; }
+		}
+		gil = PyGILState_Ensure();
+		PyObject* piece;
+		if (zstd) {
+			piece = PyObject_CallMethod(stream, "read", "n", (Py_ssize_t)EXTRACT_COPY_CHUNK);
+			finished = piece && PyBytes_Check(piece) && PyBytes_GET_SIZE(piece) == 0;
+		} else if (input) {
+			piece = PyObject_CallMethod(stream, "decompress", "On", input, (Py_ssize_t)EXTRACT_COPY_CHUNK);
+			Py_CLEAR(input);
+			PyObject* tail = piece ? PyObject_GetAttrString(stream, "unconsumed_tail") : NULL;
+			if (tail && PyBytes_Check(tail) && PyBytes_GET_SIZE(tail) > 0) input = tail;
+			else if (tail) Py_DECREF(tail);
+			else Py_CLEAR(piece);
+		} else {
+			/* All input consumed: flush whatever inflate still holds, then check the stream ended. */
+			piece = PyObject_CallMethod(stream, "flush", NULL);
+			PyObject* eof = piece ? PyObject_GetAttrString(stream, "eof") : NULL;
+			if (!eof || PyObject_IsTrue(eof) != 1) Py_CLEAR(piece);
+			Py_XDECREF(eof);
+			finished = 1;
+		}
+		PyGILState_Release(gil);
+		if (!piece || !PyBytes_Check(piece)) status = EXTRACT_DECOMPRESS_ERROR;
+		else status = extract_write(out, piece, dsize, written);
+		gil = PyGILState_Ensure();
+		Py_XDECREF(piece);
+		PyGILState_Release(gil);
+	}
+	gil = PyGILState_Ensure();
+	PyErr_Clear();
+	Py_XDECREF(input); Py_XDECREF(stream); Py_XDECREF(view);
+	PyGILState_Release(gil);
+	if (status == EXTRACT_OK && *written != dsize) status = EXTRACT_DECOMPRESS_ERROR;
+	return status;
+}
+
+static int extract_one(extract_job* job, native_rfile* pak, Py_ssize_t e, const native_path_char* output, uint8_t** buf, size_t* cap, PyObject** zstd_ctx, unsigned long long* written) {
+	const PakTocObject* toc = job->toc;
+	unsigned long long offset = toc->offset[e], size = toc->compressed_size[e], flags = toc->flags[e];
+	int compression = (int)(flags & PAK_COMPRESSION_MASK);
+	if ((flags >> PAK_ENCRYPTION_SHIFT) & PAK_ENCRYPTION_MASK) return EXTRACT_UNSUPPORTED;
+	if (compression > PAK_COMPRESSION_ZSTD || (compression == PAK_COMPRESSION_ZSTD && !job->zstd_module)) return EXTRACT_UNSUPPORTED;
+	if (size > (unsigned long long)PY_SSIZE_T_MAX) return EXTRACT_READ_ERROR;
+	FILE* out = native_fopen_path(output, "wb");
+	if (!out) return EXTRACT_WRITE_ERROR;
+	int status = EXTRACT_OK;
+	if (compression == PAK_COMPRESSION_NONE) {
+		if (ensure_capacity(buf, cap, size < EXTRACT_COPY_CHUNK ? (size_t)size : EXTRACT_COPY_CHUNK) != 0) status = EXTRACT_READ_ERROR;
+		for (unsigned long long pos = 0; status == EXTRACT_OK && pos < size; ) {
+			size_t chunk = size - pos < EXTRACT_COPY_CHUNK ? (size_t)(size - pos) : EXTRACT_COPY_CHUNK;
+			if (native_pread(pak, *buf, chunk, offset + pos) != 0) status = EXTRACT_READ_ERROR;
+			else if (fwrite(*buf, 1, chunk, out) != chunk) status = EXTRACT_WRITE_ERROR;
+			else { pos += chunk; *written += chunk; }
+		}
+	} else {
+		status = extract_compressed(job, pak, compression, offset, size, toc->decompressed_size[e], buf, cap, zstd_ctx, out, written);
+	}
+	if (fclose(out) != 0 && status == EXTRACT_OK) status = EXTRACT_WRITE_ERROR;
+	return status;
+}
+
+/* Called on the calling thread (worker 0); a False return or an exception cancels the run. */
+static void extract_report(extract_job* job, int force) {
+	unsigned long long now = native_monotonic_ns();
+	if (job->progress == Py_None || (!force && now - job->last_report < EXTRACT_PROGRESS_NS)) return;
+	job->last_report = now;
+	PyGILState_STATE gil = PyGILState_Ensure();
+	PyObject* result = PyObject_CallFunction(job->progress, "LnL", native_atomic_load(&job->done), job->count, native_atomic_load(&job->bytes_written));
+	if (!result) {
+		if (!job->error_type) PyErr_Fetch(&job->error_type, &job->error_value, &job->error_tb); else PyErr_Clear();
+		native_atomic_add(&job->cancelled, 1);
+	} else {
+		if (result == Py_False) native_atomic_add(&job->cancelled, 1);
+		Py_DECREF(result);
+	}
+	PyGILState_Release(gil);
+}
+
+static void extract_worker(void* ctx, Py_ssize_t begin, Py_ssize_t end, int worker) {
+	extract_job* job = (extract_job*)ctx;
+	native_rfile pak; uint8_t* buf = NULL; size_t cap = 0; PyObject* zstd_ctx = NULL;
+	int opened = native_rfile_open(&pak, job->pak_path) == 0;
+	unsigned long long started = native_stats_clock(&stats);
+	long long entries = 0, bytes = 0;
+	while (!native_atomic_load(&job->cancelled)) {
+		long long k = native_atomic_add(&job->next, 1);
+		if (k >= job->count) break;
+		Py_ssize_t item = job->order[k]; unsigned long long written = 0;
+		job->status[item] = (unsigned char)(opened ? extract_one(job, &pak, job->entries[item], job->outputs[item], &buf, &cap, &zstd_ctx, &written) : EXTRACT_READ_ERROR);
+		native_atomic_add(&job->bytes_written, (long long)written);
+		native_atomic_add(&job->done, 1);
+		entries++; bytes += (long long)written;
+		if (worker == 0) extract_report(job, 0);
+	}
+	native_stats_time(&stats, worker, STAT_EXTRACT_NS, started);
+	native_stats_add(&stats, worker, STAT_EXTRACT_ENTRIES, entries);
+	native_stats_add(&stats, worker, STAT_EXTRACT_BYTES, bytes);
+	if (opened) native_rfile_close(&pak);
+	PyMem_RawFree(buf);
+	if (zstd_ctx) { PyGILState_STATE gil = PyGILState_Ensure(); Py_DECREF(zstd_ctx); PyGILState_Release(gil); }
+}
+
+static PyObject* extract_entries(PyObject* self, PyObject* args, PyObject* kwds) {
+	PyObject* pak_obj; PyObject* toc_obj; PyObject* index_seq; PyObject* output_seq; PyObject* progress = Py_None; int threads = 0;
+	static char* kwlist[] = {"pak", "toc", "indices", "outputs", "threads", "progress", NULL};
+	if (!PyArg_ParseTupleAndKeywords(args, kwds, "OO!OO|iO", kwlist, &pak_obj, &PakTocType, &toc_obj, &index_seq, &output_seq, &threads, &progress)) return NULL;
+	if (threads < 0) { PyErr_SetString(PyExc_ValueError, "threads must be >= 0 (0 uses every core)"); return NULL; }
+	if (progress != Py_None && !PyCallable_Check(progress)) { PyErr_SetString(PyExc_TypeError, "progress must be callable"); return NULL; }
+	const PakTocObject* toc = (const PakTocObject*)toc_obj;
+	PyObject* indices = PySequence_Fast(index_seq, "indices must be a sequence");
+	if (!indices) return NULL;
+	PyObject* outputs = PySequence_Fast(output_seq, "outputs must be a sequence");
+	if (!outputs) { Py_DECREF(indices); return NULL; }
+	Py_ssize_t n = PySequence_Fast_GET_SIZE(indices), converted = 0;
+	PyObject* result = NULL; PyObject* status = NULL; PyObject* zstd_module = NULL; PyObject* zlib_decompressobj = NULL;
+	native_path_char* pak_path = NULL; native_path_char** paths = NULL;
+	Py_ssize_t* entries = NULL; Py_ssize_t* order = NULL; extract_row* rows = NULL;
+	if (PySequence_Fast_GET_SIZE(outputs) != n) { PyErr_SetString(PyExc_ValueError, "indices and outputs must have the same length"); goto done; }
+	entries = (Py_ssize_t*)PyMem_Malloc((n ? n : 1) * sizeof(Py_ssize_t));
+	order = (Py_ssize_t*)PyMem_Malloc((n ? n : 1) * sizeof(Py_ssize_t));
+	rows = (extract_row*)PyMem_Malloc((n ? n : 1) * sizeof(extract_row));
+	paths = (native_path_char**)PyMem_Calloc(n ? n : 1, sizeof(native_path_char*));
+	if (!entries || !order || !rows || !paths) { PyErr_NoMemory(); goto done; }
+	for (Py_ssize_t i = 0; i < n; ++i) {
+		entries[i] = PyLong_AsSsize_t(PySequence_Fast_GET_ITEM(indices, i));
+		if (entries[i] == -1 && PyErr_Occurred()) goto done;
+		if (entries[i] < 0 || entries[i] >= toc->count) { PyErr_Format(PyExc_IndexError, "PAK entry index %zd out of range", entries[i]); goto done; }
+		rows[i].offset = toc->offset[entries[i]]; rows[i].item = i;
+	}
+	for (; converted < n; ++converted) {
+		if (!(paths[converted] = native_path_from_object(PySequence_Fast_GET_ITEM(outputs, converted)))) goto done;
+	}
+	if (!(pak_path = native_path_from_object(pak_obj))) goto done;
+	PyObject* zlib = PyImport_ImportModule("zlib");
+	if (!zlib) goto done;
+	zlib_decompressobj = PyObject_GetAttrString(zlib, "decompressobj");
+	Py_DECREF(zlib);
+	if (!zlib_decompressobj) goto done;
+	/* zstandard is optional; without it zstd entries report EXTRACT_UNSUPPORTED. */
+	if (!(zstd_module = PyImport_ImportModule("zstandard"))) {
+		if (!PyErr_ExceptionMatches(PyExc_ImportError)) goto done;
+		PyErr_Clear();
+	}
+	if (!(status = PyByteArray_FromStringAndSize(NULL, n))) goto done;
+	memset(PyByteArray_AS_STRING(status), EXTRACT_PENDING, (size_t)n);
+
+	extract_job job;
+	memset(&job, 0, sizeof(job));
+	job.toc = toc; job.pak_path = pak_path; job.outputs = paths; job.entries = entries; job.order = order; job.count = n;
+	job.status = (unsigned char*)PyByteArray_AS_STRING(status);
+	job.progress = progress; job.zlib_decompressobj = zlib_decompressobj; job.zstd_module = zstd_module;
+	job.last_report = native_monotonic_ns();
+	threads = native_thread_count(threads);
+	int workers = native_worker_count(n, threads, 1);
+	Py_BEGIN_ALLOW_THREADS
+	qsort(rows, (size_t)n, sizeof(extract_row), extract_row_cmp);
+	for (Py_ssize_t i = 0; i < n; ++i) order[i] = rows[i].item;
+	native_parallel_for(workers, workers, 1, extract_worker, &job);
+	Py_END_ALLOW_THREADS
+	if (!job.error_type) {
+		extract_report(&job, 1);
+	}
+	if (job.error_type) { PyErr_Restore(job.error_type, job.error_value, job.error_tb); goto done; }
+	result = Py_BuildValue("(OL)", status, native_atomic_load(&job.bytes_written));
+done:
+	for (Py_ssize_t i = 0; i < converted; ++i) PyMem_RawFree(paths[i]);
+	PyMem_RawFree(pak_path);
+	PyMem_Free(paths); PyMem_Free(entries); PyMem_Free(order); PyMem_Free(rows);
+	Py_XDECREF(status); Py_XDECREF(zstd_module); Py_XDECREF(zlib_decompressobj);
+	Py_DECREF(indices); Py_DECREF(outputs);
+	return result;
+}
+
+/* Path index sidecar: a little-endian header, `count` ascending 64-bit hashes, one
+ * (offset, length) reference per hash into a UTF-8 string pool, then the pool itself.
+ * list_key/toc_key identify the path list and PAK TOC it was resolved against. */
+#define PATH_INDEX_MAGIC "REPIDX\0\0"
+#define PATH_INDEX_VERSION 1U
+
+typedef struct {
+	char magic[8]; uint32_t version; uint32_t reserved;
+	unsigned long long list_key; unsigned long long toc_key;
+	unsigned long long count; unsigned long long pool_size;
+} path_index_header;
+typedef struct { uint32_t offset; uint32_t length; } path_index_ref;
+typedef struct { unsigned long long hash; Py_ssize_t order; } path_index_row;
+
+static int path_index_row_cmp(const void* a, const void* b) {
+	const path_index_row* x = (const path_index_row*)a; const path_index_row* y = (const path_index_row*)b;
+	if (x->hash != y->hash) return x->hash < y->hash ? -1 : 1;
+	return x->order < y->order ? -1 : (x->order > y->order);
+}
+
+static PyObject* write_path_index(PyObject* self, PyObject* args, PyObject* kwds) {
+	PyObject* filename; PyObject* hash_seq; PyObject* path_seq; unsigned long long list_key, toc_key;
+	static char* kwlist[] = {"filename", "hashes", "paths", "list_key", "toc_key", NULL};
+	if (!PyArg_ParseTupleAndKeywords(args, kwds, "OOOKK", kwlist, &filename, &hash_seq, &path_seq, &list_key, &toc_key)) return NULL;
+	PyObject* hashes = PySequence_Fast(hash_seq, "hashes must be a sequence");
+	if (!hashes) return NULL;
+	PyObject* paths = sequence_snapshot(path_seq, "paths must be a sequence");
+	if (!paths) { Py_DECREF(hashes); return NULL; }
+	Py_ssize_t n = PySequence_Fast_GET_SIZE(hashes);
+	PyObject* result = NULL; FILE* fp = NULL;
+	path_index_row* rows = NULL; path_index_ref* refs = NULL; unsigned long long* sorted = NULL;
+	const char** utf8 = NULL;
+	if (PySequence_Fast_GET_SIZE(paths) != n) { PyErr_SetString(PyExc_ValueError, "hashes and paths must have the same length"); goto done; }
+	rows = (path_index_row*)PyMem_Malloc((n ? n : 1) * sizeof(path_index_row));
+	refs = (path_index_ref*)PyMem_Malloc((n ? n : 1) * sizeof(path_index_ref));
+	sorted = (unsigned long long*)PyMem_Malloc((n ? n : 1) * sizeof(unsigned long long));
+	utf8 = (const char**)PyMem_Malloc((n ? n : 1) * sizeof(char*));
+	if (!rows || !refs || !sorted || !utf8) { PyErr_NoMemory(); goto done; }
+	for (Py_ssize_t i = 0; i < n; ++i) {
+		if (hash_from_object(PySequence_Fast_GET_ITEM(hashes, i), &rows[i].hash) != 0) goto done;
+		rows[i].order = i;
+	}
+	Py_BEGIN_ALLOW_THREADS
+	qsort(rows, (size_t)n, sizeof(path_index_row), path_index_row_cmp);
+	Py_END_ALLOW_THREADS
+
+	/* Duplicate hashes keep their first path. */
+	Py_ssize_t count = 0; unsigned long long pool_size = 0ULL;
+	for (Py_ssize_t i = 0; i < n; ++i) {
+		if (count && sorted[count - 1] == rows[i].hash) continue;
+		PyObject* path = PySequence_Fast_GET_ITEM(paths, rows[i].order);
+		Py_ssize_t len;
+		if (!PyUnicode_Check(path)) { PyErr_SetString(PyExc_TypeError, "paths must be str"); goto done; }
+		if (!(utf8[count] = PyUnicode_AsUTF8AndSize(path, &len))) goto done;
+		if (pool_size + (unsigned long long)len > 0xFFFFFFFFULL) { PyErr_SetString(PyExc_OverflowError, "path index string pool exceeds 4 GiB"); goto done; }
+		sorted[count] = rows[i].hash;
+		refs[count].offset = (uint32_t)pool_size; refs[count].length = (uint32_t)len;
+		pool_size += (unsigned long long)len; count++;
+	}
+
+	if (!(fp = native_fopen(filename, "wb"))) goto done;
+	path_index_header header;
+	memcpy(header.magic, PATH_INDEX_MAGIC, 8);
+	header.version = PATH_INDEX_VERSION; header.reserved = 0;
+	header.list_key = list_key; header.toc_key = toc_key;
+	header.count = (unsigned long long)count; header.pool_size = pool_size;
+	int ok;
+	Py_BEGIN_ALLOW_THREADS
+	ok = fwrite(&header, sizeof(header), 1, fp) == 1
+		&& (!count || fwrite(sorted, sizeof(unsigned long long), (size_t)count, fp) == (size_t)count)
+		&& (!count || fwrite(refs, sizeof(path_index_ref), (size_t)count, fp) == (size_t)count);
+	for (Py_ssize_t i = 0; ok && i < count; ++i) {
+		ok = !refs[i].length || fwrite(utf8[i], 1, refs[i].length, fp) == refs[i].length;
+	}
+	ok = (fclose(fp) == 0) && ok;
+	Py_END_ALLOW_THREADS
+	fp = NULL;
+	if (!ok) { PyErr_SetFromErrnoWithFilenameObject(PyExc_OSError, filename); goto done; }
+	result = PyLong_FromSsize_t(count);
+done:
+	if (fp) fclose(fp);
+	PyMem_Free(rows); PyMem_Free(refs); PyMem_Free(sorted); PyMem_Free(utf8);
+	Py_DECREF(hashes); Py_DECREF(paths);
+	return result;
+}
+
+typedef struct {
+	PyObject_HEAD
+	native_mmap map;
+	const unsigned long long* hashes; const path_index_ref* refs; const char* pool;
+	Py_ssize_t count; unsigned long long pool_size;
+	unsigned long long list_key; unsigned long long toc_key;
+	Py_ssize_t busy;  /* resolve() calls reading the mapping without the GIL */
+} PathIndexFileObject;
+
+static int path_index_check_idle(PathIndexFileObject* self) {
+	if (!self->busy) return 0;
+	PyErr_SetString(PyExc_BufferError, "cannot unmap a PathIndexFile while resolve() is running");
+	return -1;
+}
+
+static int PathIndexFile_init(PathIndexFileObject* self, PyObject* args, PyObject* kwds) {
+	PyObject* filename;
+	static char* kwlist[] = {"filename", NULL};
+	if (!PyArg_ParseTupleAndKeywords(args, kwds, "O", kwlist, &filename)) return -1;
+	if (path_index_check_idle(self) != 0) return -1;
+	native_mmap_close(&self->map); self->count = 0;
+	if (native_mmap_open(&self->map, filename) != 0) return -1;
+	const uint8_t* data = self->map.data; Py_ssize_t size = self->map.size;
+	path_index_header header;
+	int valid = size >= (Py_ssize_t)sizeof(header);
+	if (valid) {
+		memcpy(&header, data, sizeof(header));
+		unsigned long long body = (unsigned long long)(size - (Py_ssize_t)sizeof(header));
+		valid = memcmp(header.magic, PATH_INDEX_MAGIC, 8) == 0 && header.version == PATH_INDEX_VERSION
+			&& header.count <= body / (sizeof(unsigned long long) + sizeof(path_index_ref))
+			&& header.count * (sizeof(unsigned long long) + sizeof(path_index_ref)) + header.pool_size == body;
+	}
+	if (!valid) {
+		native_mmap_close(&self->map);
+		PyErr_Format(PyExc_ValueError, "%R is not a valid path index file", filename);
+		return -1;
+	}
+	self->count = (Py_ssize_t)header.count; self->pool_size = header.pool_size;
+	self->list_key = header.list_key; self->toc_key = header.toc_key;
+	self->hashes = (const unsigned long long*)(data + sizeof(header));
+	self->refs = (const path_index_ref*)(self->hashes + self->count);
+	self->pool = (const char*)(self->refs + self->count);
+	return 0;
+}
+
+static void PathIndexFile_dealloc(PathIndexFileObject* self) {
+	native_mmap_close(&self->map);
+	Py_TYPE(self)->tp_free((PyObject*)self);
+}
+
+static Py_ssize_t path_index_find(const PathIndexFileObject* self, unsigned long long hash) {
+	Py_ssize_t lo = 0, hi = self->count;
+	while (lo < hi) {
+		Py_ssize_t mid = lo + (hi - lo) / 2;
+		if (self->hashes[mid] < hash) lo = mid + 1; else hi = mid;
+	}
+	return lo < self->count && self->hashes[lo] == hash ? lo : -1;
+}
+
+static PyObject* path_index_string(const PathIndexFileObject* self, Py_ssize_t row) {
+	path_index_ref ref = self->refs[row];
+	if ((unsigned long long)ref.offset + ref.length > self->pool_size) {
+		PyErr_SetString(PyExc_ValueError, "corrupt path index string reference");
+		return NULL;
+	}
+	return PyUnicode_DecodeUTF8(self->pool + ref.offset, ref.length, "strict");
+}
+
+static Py_ssize_t PathIndexFile_len(PathIndexFileObject* self) { return self->count; }
+
+static int PathIndexFile_contains(PathIndexFileObject* self, PyObject* key) {
+	unsigned long long hash;
+	if (hash_from_object(key, &hash) != 0) return -1;
+	return path_index_find(self, hash) >= 0;
+}
+
+static PyObject* PathIndexFile_get(PathIndexFileObject* self, PyObject* args) {
+	PyObject* key; PyObject* fallback = Py_None; unsigned long long hash;
+	if (!PyArg_ParseTuple(args, "O|O", &key, &fallback)) return NULL;
+	if (hash_from_object(key, &hash) != 0) return NULL;
+	Py_ssize_t row = path_index_find(self, hash);
+	if (row < 0) { Py_INCREF(fallback); return fallback; }
+	return path_index_string(self, row);
+}
+
+/* Matches every stored hash against a PakHashIndex; returns (toc_indices, paths) in hash order. */
+static PyObject* PathIndexFile_resolve(PathIndexFileObject* self, PyObject* arg) {
+	if (!PyObject_TypeCheck(arg, &PakHashIndexType)) { PyErr_SetString(PyExc_TypeError, "resolve() expects a PakHashIndex"); return NULL; }
+	const hash_table* table = &((PakHashIndexObject*)arg)->table;
+	Py_ssize_t* found = (Py_ssize_t*)PyMem_Malloc((self->count ? self->count : 1) * sizeof(Py_ssize_t));
+	if (!found) return PyErr_NoMemory();
+	Py_ssize_t hits = 0;
+	self->busy++;
+	Py_BEGIN_ALLOW_THREADS
+	for (Py_ssize_t i = 0; i < self->count; ++i) {
+		found[i] = table->slots ? table_find(table, self->hashes[i]) : -1;
+		if (found[i] >= 0) hits++;
+	}
+	Py_END_ALLOW_THREADS
+	self->busy--;
+	long long* tdata;
+	PyObject* toc_indices = new_array("q", hits, (void**)&tdata);
+	PyObject* paths = toc_indices ? PyList_New(hits) : NULL;
+	if (!paths) { Py_XDECREF(toc_indices); PyMem_Free(found); return NULL; }
+	for (Py_ssize_t i = 0, k = 0; i < self->count; ++i) {
+		if (found[i] < 0) continue;
+		PyObject* path = path_index_string(self, i);
+		if (!path) { Py_DECREF(toc_indices); Py_DECREF(paths); PyMem_Free(found); return NULL; }
+		tdata[k] = (long long)found[i]; PyList_SET_ITEM(paths, k, path); k++;
+	}
+	PyMem_Free(found);
+	return Py_BuildValue("(NN)", toc_indices, paths);
+}
+
+static PyObject* PathIndexFile_close(PathIndexFileObject* self, PyObject* unused) {
+	if (path_index_check_idle(self) != 0) return NULL;
+	native_mmap_close(&self->map); self->count = 0; self->pool_size = 0;
+	Py_RETURN_NONE;
+}
+
+static PyObject* PathIndexFile_enter(PathIndexFileObject* self, PyObject* unused) { Py_INCREF(self); return (PyObject*)self; }
+static PyObject* PathIndexFile_exit(PathIndexFileObject* self, PyObject* args) { return PathIndexFile_close(self, NULL); }
+
+static PyMethodDef PathIndexFile_methods[] = {
+	{"get", (PyCFunction)PathIndexFile_get, METH_VARARGS, "Return the stored path for a 64-bit hash or (lo, hi) pair, or default"},
+	{"resolve", (PyCFunction)PathIndexFile_resolve, METH_O, "Match stored paths against a PakHashIndex; returns (toc_indices, paths)"},
+	{"close", (PyCFunction)PathIndexFile_close, METH_NOARGS, "Unmap the index file"},
+	{"__enter__", (PyCFunction)PathIndexFile_enter, METH_NOARGS, NULL},
+	{"__exit__", (PyCFunction)PathIndexFile_exit, METH_VARARGS, NULL},
+	{NULL, NULL, 0, NULL}
+};
+
+static PyMemberDef PathIndexFile_members[] = {
+	{"list_key", T_ULONGLONG, offsetof(PathIndexFileObject, list_key), READONLY, "Key of the path list the index was built from"},
+	{"toc_key", T_ULONGLONG, offsetof(PathIndexFileObject, toc_key), READONLY, "Fingerprint of the PAK TOC the index was resolved against"},
+	{NULL, 0, 0, 0, NULL}
+};
+
+static PySequenceMethods PathIndexFile_as_sequence = {
+	.sq_length = (lenfunc)PathIndexFile_len,
+	.sq_contains = (objobjproc)PathIndexFile_contains,
+};
+
+static PyTypeObject PathIndexFileType = {
+	PyVarObject_HEAD_INIT(NULL, 0)
+	.tp_name = "fast_pakresolve.PathIndexFile",
+	.tp_doc = "Memory-mapped sidecar of resolved paths written by write_path_index().",
+	.tp_basicsize = sizeof(PathIndexFileObject),
+	.tp_flags = Py_TPFLAGS_DEFAULT,
+	.tp_new = PyType_GenericNew,
+	.tp_init = (initproc)PathIndexFile_init,
+	.tp_dealloc = (destructor)PathIndexFile_dealloc,
+	.tp_as_sequence = &PathIndexFile_as_sequence,
+	.tp_methods = PathIndexFile_methods,
+	.tp_members = PathIndexFile_members,
+};
+
+static PyObject* stats_get(PyObject* self, PyObject* args, PyObject* kwds) { return native_stats_get_method(&stats, args, kwds); }
+static PyObject* stats_enable(PyObject* self, PyObject* args, PyObject* kwds) { return native_stats_enable_method(&stats, args, kwds); }
+static PyObject* stats_reset(PyObject* self, PyObject* unused) { native_stats_reset(&stats); Py_RETURN_NONE; }
+
 static PyMethodDef Methods[] = {
-	{"resolve_paths_utf8", (PyCFunction)resolve_paths_utf8, METH_VARARGS, "Resolve paths via UTF-8 hashing; returns (remaining_paths, updated_count)"},
-	{"resolve_paths_utf16le", (PyCFunction)resolve_paths_utf16le, METH_VARARGS, "Resolve paths via UTF-16LE hashing; returns (remaining_paths, updated_count)"},
+	{"resolve_paths_utf8", (PyCFunction)(void(*)(void))resolve_paths_utf8, METH_VARARGS | METH_KEYWORDS, "Resolve paths via UTF-8 hashing on `threads` workers (0 = all cores); returns (remaining_paths, updated_count), or (remaining_paths, path_indices, toc_indices) for a PakHashIndex; status=True returns (status bytearray, toc_indices, hit_count) with one RESOLVE_* code per path"},
+	{"resolve_paths_utf16le", (PyCFunction)(void(*)(void))resolve_paths_utf16le, METH_VARARGS | METH_KEYWORDS, "Resolve paths via UTF-16LE hashing on `threads` workers (0 = all cores); returns (remaining_paths, updated_count), or (remaining_paths, path_indices, toc_indices) for a PakHashIndex; status=True returns (status bytearray, toc_indices, hit_count) with one RESOLVE_* code per path"},
 	{"murmur3_hash", (PyCFunction)murmur3_hash, METH_VARARGS, "Compute MurmurHash3 32-bit hash of bytes"},
+	{"parse_pak_toc", (PyCFunction)(void(*)(void))parse_pak_toc, METH_VARARGS | METH_KEYWORDS, "Parse a PAK header (and optional decrypted entry table) into a PakToc"},
+	{"extract_entries", (PyCFunction)(void(*)(void))extract_entries, METH_VARARGS | METH_KEYWORDS, "Extract PakToc entries to existing output directories on `threads` workers; returns (status bytearray, bytes_written). Each worker buffers 1 MiB of input and output, plus a whole compressed entry for zstd"},
+	{"write_path_index", (PyCFunction)(void(*)(void))write_path_index, METH_VARARGS | METH_KEYWORDS, "Write a sorted (hash, path) sidecar for PathIndexFile; returns the number of entries written"},
+	{"probe_patterns", (PyCFunction)(void(*)(void))probe_patterns, METH_VARARGS | METH_KEYWORDS, "Hash every dirs x stems x exts x versions combination as UTF-16LE and probe a PakHashIndex; returns [(path, toc_index)] for hits"},
+	{"scan_resolve", (PyCFunction)(void(*)(void))scan_resolve, METH_VARARGS | METH_KEYWORDS, "Scan a buffer for path-like strings (optionally limited to `extensions`) and probe a PakHashIndex with their UTF-16LE hashes; returns [(path, toc_index)] for new hits"},
+	{"murmur3_hash_many", (PyCFunction)(void(*)(void))murmur3_hash_many, METH_VARARGS | METH_KEYWORDS, "Compute MurmurHash3 32-bit hashes of many buffers; returns array('I')"},
+	{"stats", (PyCFunction)(void(*)(void))stats_get, METH_VARARGS | METH_KEYWORDS, "Return {name: value} phase timers (*_ns) and counters collected while enabled; per_thread=True gives one value per worker slot"},
+	{"reset_stats", (PyCFunction)stats_reset, METH_NOARGS, "Zero the stats() timers and counters"},
+	{"enable_stats", (PyCFunction)(void(*)(void))stats_enable, METH_VARARGS | METH_KEYWORDS, "Turn stats collection on or off (REASY_NATIVE_STATS=1 enables it at import); returns the previous state"},
 	{NULL, NULL, 0, NULL}
 };
 
@@ -158,5 +1748,34 @@ static struct PyModuleDef Module = {
 	Methods
 };
 
-PyMODINIT_FUNC PyInit_fast_pakresolve(void) { return PyModule_Create(&Module); }
+PyMODINIT_FUNC PyInit_fast_pakresolve(void) {
+	native_stats_init(&stats);
+	if (PyType_Ready(&PakTocType) < 0 || PyType_Ready(&PakHashIndexType) < 0 || PyType_Ready(&UnresolvedHashesType) < 0
+		|| PyType_Ready(&PathIndexFileType) < 0) return NULL;
+	if (!array_type) {
+		PyObject* array_mod = PyImport_ImportModule("array");
+		if (!array_mod) return NULL;
+		array_type = PyObject_GetAttrString(array_mod, "array");
+		Py_DECREF(array_mod);
+		if (!array_type) return NULL;
+	}
+	PyObject* m = PyModule_Create(&Module);
+	if (!m) return NULL;
+	Py_INCREF(&PakHashIndexType);
+	if (PyModule_AddObject(m, "PakHashIndex", (PyObject*)&PakHashIndexType) < 0) { Py_DECREF(&PakHashIndexType); Py_DECREF(m); return NULL; }
+	if (PyModule_AddIntConstant(m, "EXTRACT_OK", EXTRACT_OK) < 0 || PyModule_AddIntConstant(m, "EXTRACT_PENDING", EXTRACT_PENDING) < 0
+		|| PyModule_AddIntConstant(m, "EXTRACT_READ_ERROR", EXTRACT_READ_ERROR) < 0 || PyModule_AddIntConstant(m, "EXTRACT_WRITE_ERROR", EXTRACT_WRITE_ERROR) < 0
+		|| PyModule_AddIntConstant(m, "EXTRACT_UNSUPPORTED", EXTRACT_UNSUPPORTED) < 0 || PyModule_AddIntConstant(m, "EXTRACT_DECOMPRESS_ERROR", EXTRACT_DECOMPRESS_ERROR) < 0
+		|| PyModule_AddIntConstant(m, "RESOLVE_MISS", RESOLVE_MISS) < 0 || PyModule_AddIntConstant(m, "RESOLVE_HIT", RESOLVE_HIT) < 0
+		|| PyModule_AddIntConstant(m, "RESOLVE_ALREADY_SET", RESOLVE_ALREADY_SET) < 0 || PyModule_AddIntConstant(m, "RESOLVE_NOT_STRING", RESOLVE_NOT_STRING) < 0) {
+		Py_DECREF(m); return NULL;
+	}
+	Py_INCREF(&PakTocType);
+	if (PyModule_AddObject(m, "PakToc", (PyObject*)&PakTocType) < 0) { Py_DECREF(&PakTocType); Py_DECREF(m); return NULL; }
+	Py_INCREF(&UnresolvedHashesType);
+	if (PyModule_AddObject(m, "UnresolvedHashes", (PyObject*)&UnresolvedHashesType) < 0) { Py_DECREF(&UnresolvedHashesType); Py_DECREF(m); return NULL; }
+	Py_INCREF(&PathIndexFileType);
+	if (PyModule_AddObject(m, "PathIndexFile", (PyObject*)&PathIndexFileType) < 0) { Py_DECREF(&PathIndexFileType); Py_DECREF(m); return NULL; }
+	return m;
+}
 
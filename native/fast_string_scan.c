@@ -1,24 +1,24 @@
 #define PY_SSIZE_T_CLEAN
 #include <Python.h>
 #include <stdint.h>
+#include <string.h>
 
-static int is_utf8_candidate_byte(uint8_t value) {
-	return (value >= 0x20 && value <= 0x7E) || value >= 0x80;
-}
-
-static int unicode_is_printable(PyObject* value) {
-	Py_ssize_t length = PyUnicode_GetLength(value);
-	if (length < 0) return -1;
+#include "native_file.h"
+#include "native_scan.h"
+#include "native_stats.h"
 
-	int kind = PyUnicode_KIND(value);
-	void* data = PyUnicode_DATA(value);
-	for (Py_ssize_t i = 0; i < length; ++i) {
-		if (!Py_UNICODE_ISPRINTABLE(PyUnicode_READ(kind, data, i))) {
-			return 0;
-		}
-	}
-	return 1;
-}
+/* Phase timers (*_ns) and counters behind stats(); see native_stats.h. */
+enum {
+	STAT_SCAN_CALLS, STAT_SCAN_NS, STAT_BYTES_SCANNED, STAT_SPANS,
+	STAT_MATERIALIZE_NS, STAT_STRINGS_ALLOCATED, STAT_STRING_BYTES,
+	STAT_MERGE_NS, STAT_CARRY_BYTES,
+};
+static const char* const stat_names[] = {
+	"scan_calls", "scan_ns", "bytes_scanned", "spans",
+	"materialize_ns", "strings_allocated", "string_bytes",
+	"merge_ns", "carry_bytes",
+};
+static native_stats stats = NATIVE_STATS_INIT(stat_names);
 
 static PyObject* unicode_from_utf16_code_units(
 	const uint8_t* data,
@@ -40,107 +40,688 @@ static PyObject* unicode_from_utf16_code_units(
 	return value;
 }
 
-static PyObject* extract_strings(PyObject* self, PyObject* args) {
-	PyObject* source;
-	Py_ssize_t min_length;
-	if (!PyArg_ParseTuple(args, "On", &source, &min_length)) {
-		return NULL;
+/* Appends the strings for spans to list; UTF-8 spans were validated while scanning. */
+static int materialize_spans(PyObject* list, const uint8_t* data, Py_ssize_t base, const scan_span* spans, Py_ssize_t count, int utf8) {
+	if (native_stats_on(&stats)) {
+		long long bytes = 0;
+		for (Py_ssize_t i = 0; i < count; ++i) bytes += spans[i].length;
+		native_stats_add(&stats, 0, STAT_STRINGS_ALLOCATED, count);
+		native_stats_add(&stats, 0, STAT_STRING_BYTES, bytes);
 	}
+	for (Py_ssize_t i = 0; i < count; ++i) {
+		const scan_span* span = &spans[i];
+		PyObject* value;
+		if (!utf8) {
+			value = unicode_from_utf16_code_units(data, span->offset - base, span->offset - base + span->length, span->maxchar > 127 ? span->maxchar : 127);
+		} else {
+			value = PyUnicode_DecodeUTF8((const char*)data + (span->offset - base), span->length, "strict");
+		}
+		if (!value || PyList_Append(list, value) != 0) {
+			Py_XDECREF(value);
+			return -1;
+		}
+		Py_DECREF(value);
+	}
+	return 0;
+}
+
+/* scan_view with the scan phase recorded in stats. */
+static scan_job* timed_scan_view(const Py_buffer* view, Py_ssize_t min_length, int threads, const string_filter* filter) {
+	unsigned long long started = native_stats_clock(&stats);
+	scan_job* job = scan_view(view, min_length, threads, filter);
+	if (job && started) {
+		long long spans = 0;
+		for (int w = 0; w < job->workers; ++w) {
+			for (int s = 0; s < 3; ++s) spans += job->spans[w][s].count;
+		}
+		native_stats_time(&stats, 0, STAT_SCAN_NS, started);
+		native_stats_add(&stats, 0, STAT_SCAN_CALLS, 1);
+		native_stats_add(&stats, 0, STAT_BYTES_SCANNED, view->len);
+		native_stats_add(&stats, 0, STAT_SPANS, spans);
+	}
+	return job;
+}
+
+static int check_scan_args(Py_ssize_t min_length, int threads) {
 	if (min_length <= 0) {
 		PyErr_SetString(PyExc_ValueError, "min_length must be positive");
-		return NULL;
+		return -1;
 	}
 	if (min_length > PY_SSIZE_T_MAX / 2) {
 		PyErr_SetString(PyExc_OverflowError, "min_length is too large");
+		return -1;
+	}
+	if (threads < 0) {
+		PyErr_SetString(PyExc_ValueError, "threads must be >= 0 (0 uses every core)");
+		return -1;
+	}
+	return 0;
+}
+
+typedef struct {
+	PyObject_HEAD
+	string_filter filter;
+} StringFilterObject;
+
+static void string_filter_free(string_filter* filter) {
+	PyMem_Free(filter->next);
+	PyMem_Free(filter->terminal);
+	filter->next = NULL;
+	filter->terminal = NULL;
+	filter->nodes = 0;
+}
+
+/* Builds the trie over the needles' UTF-8 bytes, then for substring mode fills the missing
+ * transitions breadth-first from the failure links and propagates terminal flags along them. */
+static int string_filter_build(string_filter* filter, PyObject* needles) {
+	PyObject* list = PySequence_List(needles);
+	if (!list) return -1;
+	Py_ssize_t n = PyList_GET_SIZE(list), total = 1;
+	for (Py_ssize_t i = 0; i < n; ++i) {
+		PyObject* item = PyList_GET_ITEM(list, i);
+		if (!PyUnicode_Check(item)) {
+			PyErr_SetString(PyExc_TypeError, "needles must be str");
+			Py_DECREF(list);
+			return -1;
+		}
+		Py_ssize_t length;
+		if (!PyUnicode_AsUTF8AndSize(item, &length)) {
+			Py_DECREF(list);
+			return -1;
+		}
+		if (length > 0x7FFFFFFF / 256 - total) {
+			PyErr_SetString(PyExc_OverflowError, "needles are too long");
+			Py_DECREF(list);
+			return -1;
+		}
+		total += length;
+	}
+	filter->next = (int32_t*)PyMem_Malloc((size_t)total * 256 * sizeof(int32_t));
+	filter->terminal = (uint8_t*)PyMem_Calloc((size_t)total, 1);
+	int32_t* fail = (int32_t*)PyMem_Malloc((size_t)total * sizeof(int32_t));
+	int32_t* queue = (int32_t*)PyMem_Malloc((size_t)total * sizeof(int32_t));
+	if (!filter->next || !filter->terminal || !fail || !queue) {
+		PyMem_Free(fail);
+		PyMem_Free(queue);
+		string_filter_free(filter);
+		Py_DECREF(list);
+		PyErr_NoMemory();
+		return -1;
+	}
+	memset(filter->next, 0xFF, (size_t)total * 256 * sizeof(int32_t));
+	filter->nodes = 1;
+	for (Py_ssize_t i = 0; i < n; ++i) {
+		Py_ssize_t length;
+		const uint8_t* needle = (const uint8_t*)PyUnicode_AsUTF8AndSize(PyList_GET_ITEM(list, i), &length);
+		int32_t state = 0;
+		for (Py_ssize_t k = 0; k < length; ++k) {
+			uint8_t byte = needle[k];
+			if (filter->ignore_case && byte >= 'A' && byte <= 'Z') byte = (uint8_t)(byte + 32);
+			int32_t* slot = &filter->next[(Py_ssize_t)state * 256 + byte];
+			if (*slot < 0) *slot = (int32_t)filter->nodes++;
+			state = *slot;
+		}
+		filter->terminal[state] = 1;
+	}
+	Py_DECREF(list);
+
+	if (!filter->prefix) {
+		Py_ssize_t head = 0, tail = 0;
+		for (int byte = 0; byte < 256; ++byte) {
+			int32_t* slot = &filter->next[byte];
+			if (*slot < 0) {
+				*slot = 0;
+			} else {
+				fail[*slot] = 0;
+				queue[tail++] = *slot;
+			}
+		}
+		while (head < tail) {
+			int32_t node = queue[head++];
+			if (filter->terminal[fail[node]]) filter->terminal[node] = 1;
+			for (int byte = 0; byte < 256; ++byte) {
+				int32_t* slot = &filter->next[(Py_ssize_t)node * 256 + byte];
+				int32_t fallback = filter->next[(Py_ssize_t)fail[node] * 256 + byte];
+				if (*slot < 0) {
+					*slot = fallback;
+				} else {
+					fail[*slot] = fallback;
+					queue[tail++] = *slot;
+				}
+			}
+		}
+	}
+	PyMem_Free(fail);
+	PyMem_Free(queue);
+	return 0;
+}
+
+static int StringFilter_init(StringFilterObject* self, PyObject* args, PyObject* kwds) {
+	PyObject* needles;
+	int prefix = 0, ignore_case = 0;
+	static char* kwlist[] = {"needles", "prefix", "ignore_case", NULL};
+	if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|pp", kwlist, &needles, &prefix, &ignore_case)) {
+		return -1;
+	}
+	string_filter_free(&self->filter);
+	self->filter.prefix = prefix;
+	self->filter.ignore_case = ignore_case;
+	return string_filter_build(&self->filter, needles);
+}
+
+static void StringFilter_dealloc(StringFilterObject* self) {
+	string_filter_free(&self->filter);
+	Py_TYPE(self)->tp_free((PyObject*)self);
+}
+
+static PyObject* StringFilter_matches(StringFilterObject* self, PyObject* value) {
+	Py_ssize_t length;
+	const char* utf8 = PyUnicode_Check(value) ? PyUnicode_AsUTF8AndSize(value, &length) : NULL;
+	if (!utf8) {
+		if (!PyErr_Occurred()) PyErr_SetString(PyExc_TypeError, "matches() expects str");
+		return NULL;
+	}
+	if (!self->filter.nodes) {
+		PyErr_SetString(PyExc_ValueError, "StringFilter is not initialized");
+		return NULL;
+	}
+	return PyBool_FromLong(string_filter_match(&self->filter, (const uint8_t*)utf8, length, 1));
+}
+
+static PyMethodDef StringFilter_methods[] = {
+	{"matches", (PyCFunction)StringFilter_matches, METH_O, "Return True if the string passes the filter"},
+	{NULL, NULL, 0, NULL}
+};
+
+static PyTypeObject StringFilterType = {
+	PyVarObject_HEAD_INIT(NULL, 0)
+	.tp_name = "fast_string_scan.StringFilter",
+	.tp_doc = "StringFilter(needles, prefix=False, ignore_case=False): compiled multi-needle matcher for the scanners' needles= argument.",
+	.tp_basicsize = sizeof(StringFilterObject),
+	.tp_flags = Py_TPFLAGS_DEFAULT,
+	.tp_new = PyType_GenericNew,
+	.tp_init = (initproc)StringFilter_init,
+	.tp_dealloc = (destructor)StringFilter_dealloc,
+	.tp_methods = StringFilter_methods,
+};
+
+/* needles= accepts None, a StringFilter, or an iterable of substrings compiled on the spot.
+ * Returns a new reference, or NULL with *out NULL for None. */
+static int filter_from_object(PyObject* needles, PyObject** out) {
+	*out = NULL;
+	if (needles == Py_None) return 0;
+	if (PyObject_TypeCheck(needles, &StringFilterType)) {
+		if (!((StringFilterObject*)needles)->filter.nodes) {
+			PyErr_SetString(PyExc_ValueError, "StringFilter is not initialized");
+			return -1;
+		}
+		Py_INCREF(needles);
+		*out = needles;
+		return 0;
+	}
+	*out = PyObject_CallOneArg((PyObject*)&StringFilterType, needles);
+	return *out ? 0 : -1;
+}
+
+#define FILTER_OF(obj) ((obj) ? &((StringFilterObject*)(obj))->filter : NULL)
+
+static PyObject* extract_strings(PyObject* self, PyObject* args, PyObject* kwds) {
+	PyObject* source;
+	Py_ssize_t min_length;
+	int threads = 0;
+	PyObject* needles = Py_None;
+	PyObject* filter;
+	static char* kwlist[] = {"source", "min_length", "threads", "needles", NULL};
+	if (!PyArg_ParseTupleAndKeywords(args, kwds, "On|iO", kwlist, &source, &min_length, &threads, &needles)) {
+		return NULL;
+	}
+	if (check_scan_args(min_length, threads) != 0 || filter_from_object(needles, &filter) != 0) {
 		return NULL;
 	}
 
 	Py_buffer view;
 	if (PyObject_GetBuffer(source, &view, PyBUF_CONTIG_RO) != 0) {
+		Py_XDECREF(filter);
 		return NULL;
 	}
-
-	const uint8_t* data = (const uint8_t*)view.buf;
-	Py_ssize_t data_length = view.len;
-	Py_ssize_t min_bytes = min_length * 2;
-	PyObject* strings = PyList_New(0);
-	if (!strings) {
+	scan_job* job = timed_scan_view(&view, min_length, threads, FILTER_OF(filter));
+	Py_XDECREF(filter);
+	if (!job) {
 		PyBuffer_Release(&view);
 		return NULL;
 	}
 
-	for (Py_ssize_t parity = 0; parity <= 1; ++parity) {
-		Py_ssize_t i = parity;
-		while (i <= data_length - min_bytes) {
-			if (!(data[i] >= 32 && data[i] <= 126 && data[i + 1] == 0)) {
-				i += 2;
-				continue;
+	unsigned long long started = native_stats_clock(&stats);
+	PyObject* strings = PyList_New(0);
+	for (int s = 0; strings && s < 3; ++s) {
+		for (int w = 0; w < job->workers; ++w) {
+			if (materialize_spans(strings, job->data, 0, job->spans[w][s].items, job->spans[w][s].count, s == SCAN_UTF8) != 0) {
+				Py_CLEAR(strings);
+				break;
 			}
+		}
+	}
+	native_stats_time(&stats, 0, STAT_MATERIALIZE_NS, started);
+	scan_job_free(job);
+	PyBuffer_Release(&view);
+	return strings;
+}
 
-			Py_ssize_t j = i;
-			Py_UCS4 maxchar = 0;
-			while (j <= data_length - 2) {
-				Py_UCS4 codepoint = (Py_UCS4)data[j] | ((Py_UCS4)data[j + 1] << 8);
-				if (codepoint == 0 || !Py_UNICODE_ISPRINTABLE(codepoint)) {
-					break;
-				}
-				if (codepoint > maxchar) maxchar = codepoint;
-				j += 2;
-			}
+/* Offset-sorted records returned by extract_string_spans; the layout is exported through the
+ * buffer protocol as struct format "QII". */
+enum { ENCODING_UTF16LE, ENCODING_UTF8 };
 
-			if ((j - i) / 2 >= min_length) {
-				PyObject* value = unicode_from_utf16_code_units(data, i, j, maxchar);
-				if (!value || PyList_Append(strings, value) != 0) {
-					Py_XDECREF(value);
-					Py_DECREF(strings);
-					PyBuffer_Release(&view);
-					return NULL;
-				}
-				Py_DECREF(value);
-				i = j + 2;
-			} else {
-				i += 2;
+typedef struct {
+	uint64_t offset;
+	uint32_t length;
+	uint32_t encoding;
+} string_span_record;
+
+typedef struct {
+	PyObject_HEAD
+	Py_buffer view;
+	string_span_record* records;
+	Py_ssize_t count;
+	Py_ssize_t shape[1];
+	Py_ssize_t strides[1];
+} StringSpansObject;
+
+static void StringSpans_dealloc(StringSpansObject* self) {
+	PyMem_Free(self->records);
+	if (self->view.obj) PyBuffer_Release(&self->view);
+	Py_TYPE(self)->tp_free((PyObject*)self);
+}
+
+static Py_ssize_t StringSpans_len(StringSpansObject* self) {
+	return self->count;
+}
+
+static int StringSpans_check_index(StringSpansObject* self, Py_ssize_t i) {
+	if (i < 0 || i >= self->count) {
+		PyErr_SetString(PyExc_IndexError, "span index out of range");
+		return -1;
+	}
+	return 0;
+}
+
+/* Strings are decoded only when requested; spans were validated while scanning. */
+static PyObject* StringSpans_item(StringSpansObject* self, Py_ssize_t i) {
+	if (StringSpans_check_index(self, i) != 0) return NULL;
+	const string_span_record* record = &self->records[i];
+	const char* data = (const char*)self->view.buf + record->offset;
+	if (record->encoding == ENCODING_UTF8) return PyUnicode_DecodeUTF8(data, (Py_ssize_t)record->length, "strict");
+	int byteorder = -1;
+	return PyUnicode_DecodeUTF16(data, (Py_ssize_t)record->length, "strict", &byteorder);
+}
+
+static PyObject* StringSpans_record(StringSpansObject* self, PyObject* arg) {
+	Py_ssize_t i = PyNumber_AsSsize_t(arg, PyExc_IndexError);
+	if (i == -1 && PyErr_Occurred()) return NULL;
+	if (i < 0) i += self->count;
+	if (StringSpans_check_index(self, i) != 0) return NULL;
+	const string_span_record* record = &self->records[i];
+	return Py_BuildValue("(KII)", (unsigned long long)record->offset, (unsigned int)record->length, (unsigned int)record->encoding);
+}
+
+static int StringSpans_getbuffer(StringSpansObject* self, Py_buffer* view, int flags) {
+	if (flags & PyBUF_WRITABLE) {
+		PyErr_SetString(PyExc_BufferError, "StringSpans records are read-only");
+		view->obj = NULL;
+		return -1;
+	}
+	view->obj = (PyObject*)self;
+	Py_INCREF(self);
+	view->buf = self->records;
+	view->len = self->count * (Py_ssize_t)sizeof(string_span_record);
+	view->readonly = 1;
+	view->itemsize = sizeof(string_span_record);
+	view->format = (flags & PyBUF_FORMAT) ? "QII" : NULL;
+	view->ndim = 1;
+	view->shape = (flags & PyBUF_ND) ? self->shape : NULL;
+	view->strides = (flags & PyBUF_STRIDES) == PyBUF_STRIDES ? self->strides : NULL;
+	view->suboffsets = NULL;
+	view->internal = NULL;
+	return 0;
+}
+
+static PySequenceMethods StringSpans_as_sequence = {
+	.sq_length = (lenfunc)StringSpans_len,
+	.sq_item = (ssizeargfunc)StringSpans_item,
+};
+
+static PyBufferProcs StringSpans_as_buffer = {
+	.bf_getbuffer = (getbufferproc)StringSpans_getbuffer,
+};
+
+static PyMethodDef StringSpans_methods[] = {
+	{"record", (PyCFunction)StringSpans_record, METH_O, "Return (offset, byte_length, encoding) for span i"},
+	{NULL, NULL, 0, NULL}
+};
+
+static PyTypeObject StringSpansType = {
+	PyVarObject_HEAD_INIT(NULL, 0)
+	.tp_name = "fast_string_scan.StringSpans",
+	.tp_doc = "Offset-sorted (offset u64, byte_length u32, encoding u32) records over a scanned buffer; indexing decodes one string.",
+	.tp_basicsize = sizeof(StringSpansObject),
+	.tp_flags = Py_TPFLAGS_DEFAULT,
+	.tp_dealloc = (destructor)StringSpans_dealloc,
+	.tp_as_sequence = &StringSpans_as_sequence,
+	.tp_as_buffer = &StringSpans_as_buffer,
+	.tp_methods = StringSpans_methods,
+};
+
+/* Merges the three offset-sorted streams; UTF-16 parity spans never share an offset, and a UTF-8
+ * span at the same offset sorts after the UTF-16 one. */
+static int spans_merge(StringSpansObject* spans, const scan_job* job) {
+	Py_ssize_t total = 0;
+	for (int w = 0; w < job->workers; ++w) {
+		for (int s = 0; s < 3; ++s) total += job->spans[w][s].count;
+	}
+	spans->records = (string_span_record*)PyMem_Malloc((total ? total : 1) * sizeof(string_span_record));
+	if (!spans->records) {
+		PyErr_NoMemory();
+		return -1;
+	}
+	int worker[3] = {0, 0, 0};
+	Py_ssize_t next[3] = {0, 0, 0};
+	for (Py_ssize_t k = 0; k < total; ++k) {
+		int best = -1;
+		for (int s = 0; s < 3; ++s) {
+			while (worker[s] < job->workers && next[s] == job->spans[worker[s]][s].count) {
+				worker[s]++;
+				next[s] = 0;
 			}
+			if (worker[s] == job->workers) continue;
+			if (best < 0 || job->spans[worker[s]][s].items[next[s]].offset < job->spans[worker[best]][best].items[next[best]].offset) best = s;
 		}
+		const scan_span* span = &job->spans[worker[best]][best].items[next[best]++];
+		if ((unsigned long long)span->length > 0xFFFFFFFFULL) {
+			PyErr_SetString(PyExc_OverflowError, "string span is longer than 4 GiB");
+			return -1;
+		}
+		spans->records[k].offset = (uint64_t)span->offset;
+		spans->records[k].length = (uint32_t)span->length;
+		spans->records[k].encoding = best == SCAN_UTF8 ? ENCODING_UTF8 : ENCODING_UTF16LE;
+	}
+	spans->count = total;
+	spans->shape[0] = total;
+	spans->strides[0] = sizeof(string_span_record);
+	return 0;
+}
+
+static PyObject* extract_string_spans(PyObject* self, PyObject* args, PyObject* kwds) {
+	PyObject* source;
+	Py_ssize_t min_length;
+	int threads = 0;
+	PyObject* needles = Py_None;
+	PyObject* filter;
+	static char* kwlist[] = {"source", "min_length", "threads", "needles", NULL};
+	if (!PyArg_ParseTupleAndKeywords(args, kwds, "On|iO", kwlist, &source, &min_length, &threads, &needles)) {
+		return NULL;
+	}
+	if (check_scan_args(min_length, threads) != 0 || filter_from_object(needles, &filter) != 0) {
+		return NULL;
 	}
 
-	Py_ssize_t utf8_min_bytes = min_length > 10 ? min_length : 10;
-	Py_ssize_t i = 0;
-	while (i < data_length) {
-		while (i < data_length && !is_utf8_candidate_byte(data[i])) i++;
-		Py_ssize_t start = i;
-		while (i < data_length && is_utf8_candidate_byte(data[i])) i++;
+	StringSpansObject* spans = PyObject_New(StringSpansObject, &StringSpansType);
+	if (!spans) {
+		Py_XDECREF(filter);
+		return NULL;
+	}
+	spans->records = NULL;
+	spans->count = 0;
+	spans->view.obj = NULL;
+	/* The source buffer stays exported for the lifetime of the spans so items can be decoded later. */
+	if (PyObject_GetBuffer(source, &spans->view, PyBUF_CONTIG_RO) != 0) {
+		spans->view.obj = NULL;
+		Py_XDECREF(filter);
+		Py_DECREF(spans);
+		return NULL;
+	}
+	scan_job* job = timed_scan_view(&spans->view, min_length, threads, FILTER_OF(filter));
+	Py_XDECREF(filter);
+	if (!job) {
+		Py_DECREF(spans);
+		return NULL;
+	}
+	unsigned long long started = native_stats_clock(&stats);
+	int merged = spans_merge(spans, job);
+	native_stats_time(&stats, 0, STAT_MERGE_NS, started);
+	scan_job_free(job);
+	if (merged != 0) {
+		Py_DECREF(spans);
+		return NULL;
+	}
+	return (PyObject*)spans;
+}
+
+/* Streaming scanner: either fed successive chunks, or iterated over a memory-mapped file in
+ * chunk_size windows. Each batch lists the strings finished so far, UTF-16 parity 0, parity 1,
+ * then UTF-8; only bytes of still-open runs are carried between chunks. */
+typedef struct {
+	PyObject_HEAD
+	scan_state state;
+	scan_mask_fn masks;
+	uint8_t* carry;
+	Py_ssize_t carry_base;
+	Py_ssize_t carry_length;
+	Py_ssize_t carry_capacity;
+	native_mmap map;
+	int mapped;
+	Py_ssize_t mapped_pos;
+	Py_ssize_t chunk_size;
+	int finished;
+	PyObject* filter;
+} StringScannerObject;
+
+static int StringScanner_init(StringScannerObject* self, PyObject* args, PyObject* kwds) {
+	Py_ssize_t min_length;
+	PyObject* path = Py_None;
+	Py_ssize_t chunk_size = 1 << 24;
+	PyObject* needles = Py_None;
+	static char* kwlist[] = {"min_length", "path", "chunk_size", "needles", NULL};
+	if (!PyArg_ParseTupleAndKeywords(args, kwds, "n|OnO", kwlist, &min_length, &path, &chunk_size, &needles)) {
+		return -1;
+	}
+	if (min_length <= 0) {
+		PyErr_SetString(PyExc_ValueError, "min_length must be positive");
+		return -1;
+	}
+	if (min_length > PY_SSIZE_T_MAX / 2) {
+		PyErr_SetString(PyExc_OverflowError, "min_length is too large");
+		return -1;
+	}
+	if (chunk_size <= 0) {
+		PyErr_SetString(PyExc_ValueError, "chunk_size must be positive");
+		return -1;
+	}
+	if (self->mapped) native_mmap_close(&self->map);
+	PyMem_RawFree(self->carry);
+	self->carry = NULL;
+	self->carry_base = self->carry_length = self->carry_capacity = 0;
+	self->mapped = 0;
+	self->mapped_pos = 0;
+	self->chunk_size = chunk_size;
+	self->finished = 0;
+	self->masks = scan_select_masks();
+	scan_state_init(&self->state, min_length);
+	Py_CLEAR(self->filter);
+	if (filter_from_object(needles, &self->filter) != 0) return -1;
+	if (path != Py_None) {
+		if (native_mmap_open(&self->map, path) != 0) return -1;
+		self->mapped = 1;
+	}
+	return 0;
+}
 
-		Py_ssize_t length = i - start;
-		if (length < utf8_min_bytes) continue;
+static void StringScanner_dealloc(StringScannerObject* self) {
+	if (self->mapped) native_mmap_close(&self->map);
+	PyMem_RawFree(self->carry);
+	Py_XDECREF(self->filter);
+	Py_TYPE(self)->tp_free((PyObject*)self);
+}
 
-		PyObject* value = PyUnicode_DecodeUTF8((const char*)data + start, length, "strict");
-		if (!value) {
-			if (PyErr_ExceptionMatches(PyExc_UnicodeDecodeError)) {
-				PyErr_Clear();
-				continue;
+/* Scans data (absolute offsets from base) and returns the finished strings as a new list;
+ * fresh is the number of bytes not seen by earlier batches. */
+static PyObject* scanner_batch(StringScannerObject* self, const uint8_t* data, Py_ssize_t base, Py_ssize_t length, int final, Py_ssize_t fresh) {
+	span_list spans[3] = {{NULL, 0, 0}, {NULL, 0, 0}, {NULL, 0, 0}};
+	PyObject* strings = NULL;
+	unsigned long long started = native_stats_clock(&stats);
+	if (scan_advance(&self->state, self->masks, data, base, length, final, spans) != 0) {
+		PyErr_NoMemory();
+	} else if ((strings = PyList_New(0)) != NULL) {
+		if (started) {
+			native_stats_time(&stats, 0, STAT_SCAN_NS, started);
+			native_stats_add(&stats, 0, STAT_SCAN_CALLS, 1);
+			native_stats_add(&stats, 0, STAT_BYTES_SCANNED, fresh);
+			native_stats_add(&stats, 0, STAT_SPANS, spans[0].count + spans[1].count + spans[2].count);
+			started = native_stats_clock(&stats);
+		}
+		for (int s = 0; s < 3; ++s) {
+			if (self->filter) spans_filter(&spans[s], FILTER_OF(self->filter), data, base, s == SCAN_UTF8);
+			if (materialize_spans(strings, data, base, spans[s].items, spans[s].count, s == SCAN_UTF8) != 0) {
+				Py_CLEAR(strings);
+				break;
 			}
-			Py_DECREF(strings);
-			PyBuffer_Release(&view);
-			return NULL;
 		}
+	}
+	native_stats_time(&stats, 0, STAT_MATERIALIZE_NS, started);
+	for (int s = 0; s < 3; ++s) span_list_free(&spans[s]);
+	return strings;
+}
+
+static int scanner_check_feed(StringScannerObject* self) {
+	if (self->mapped) {
+		PyErr_SetString(PyExc_TypeError, "file scanners are iterated, not fed");
+		return -1;
+	}
+	if (self->finished) {
+		PyErr_SetString(PyExc_ValueError, "scanner is already finished");
+		return -1;
+	}
+	return 0;
+}
 
-		int printable = unicode_is_printable(value);
-		if (printable < 0 || (printable && PyList_Append(strings, value) != 0)) {
-			Py_DECREF(value);
-			Py_DECREF(strings);
+static PyObject* StringScanner_feed(StringScannerObject* self, PyObject* source) {
+	if (scanner_check_feed(self) != 0) return NULL;
+	Py_buffer view;
+	if (PyObject_GetBuffer(source, &view, PyBUF_CONTIG_RO) != 0) {
+		return NULL;
+	}
+	if (view.len > PY_SSIZE_T_MAX - self->carry_length) {
+		PyBuffer_Release(&view);
+		return PyErr_NoMemory();
+	}
+	Py_ssize_t needed = self->carry_length + view.len;
+	if (needed > self->carry_capacity) {
+		Py_ssize_t capacity = self->carry_capacity ? self->carry_capacity : 4096;
+		while (capacity < needed) capacity = capacity > PY_SSIZE_T_MAX / 2 ? needed : capacity * 2;
+		uint8_t* carry = (uint8_t*)PyMem_RawRealloc(self->carry, (size_t)capacity);
+		if (!carry) {
 			PyBuffer_Release(&view);
-			return NULL;
+			return PyErr_NoMemory();
 		}
-		Py_DECREF(value);
+		self->carry = carry;
+		self->carry_capacity = capacity;
 	}
-
+	if (view.len) memcpy(self->carry + self->carry_length, view.buf, (size_t)view.len);
+	native_stats_add(&stats, 0, STAT_CARRY_BYTES, view.len);
+	self->carry_length = needed;
+	Py_ssize_t fresh = view.len;
 	PyBuffer_Release(&view);
+
+	PyObject* strings = scanner_batch(self, self->carry, self->carry_base, self->carry_length, 0, fresh);
+	if (!strings) return NULL;
+	Py_ssize_t keep = scan_state_keep(&self->state);
+	Py_ssize_t end = self->carry_base + self->carry_length;
+	if (keep > end) keep = end;
+	Py_ssize_t drop = keep - self->carry_base;
+	if (drop > 0) {
+		memmove(self->carry, self->carry + drop, (size_t)(self->carry_length - drop));
+		self->carry_length -= drop;
+		self->carry_base = keep;
+	}
 	return strings;
 }
 
+static PyObject* StringScanner_finish(StringScannerObject* self, PyObject* unused) {
+	if (scanner_check_feed(self) != 0) return NULL;
+	PyObject* strings = scanner_batch(self, self->carry, self->carry_base, self->carry_length, 1, 0);
+	if (!strings) return NULL;
+	PyMem_RawFree(self->carry);
+	self->carry = NULL;
+	self->carry_length = self->carry_capacity = 0;
+	self->finished = 1;
+	return strings;
+}
+
+static PyObject* StringScanner_iter(StringScannerObject* self) {
+	if (!self->mapped) {
+		PyErr_SetString(PyExc_TypeError, "only scanners created with a path can be iterated");
+		return NULL;
+	}
+	Py_INCREF(self);
+	return (PyObject*)self;
+}
+
+/* The whole file stays mapped, so each window only extends the scanned length; empty batches are skipped. */
+static PyObject* StringScanner_iternext(StringScannerObject* self) {
+	while (self->mapped && !self->finished) {
+		Py_ssize_t size = self->map.size;
+		Py_ssize_t end = size - self->mapped_pos > self->chunk_size ? self->mapped_pos + self->chunk_size : size;
+		int final = end == size;
+		PyObject* strings = scanner_batch(self, self->map.data, 0, end, final, end - self->mapped_pos);
+		if (!strings) return NULL;
+		self->mapped_pos = end;
+		if (final) {
+			self->finished = 1;
+			native_mmap_close(&self->map);
+		}
+		if (PyList_GET_SIZE(strings) > 0) return strings;
+		Py_DECREF(strings);
+	}
+	return NULL;
+}
+
+static PyMethodDef StringScanner_methods[] = {
+	{"feed", (PyCFunction)StringScanner_feed, METH_O, "Scan the next chunk of bytes; returns the strings finished so far"},
+	{"finish", (PyCFunction)StringScanner_finish, METH_NOARGS, "Flush strings still open at the end of the input"},
+	{NULL, NULL, 0, NULL}
+};
+
+static PyTypeObject StringScannerType = {
+	PyVarObject_HEAD_INIT(NULL, 0)
+	.tp_name = "fast_string_scan.StringScanner",
+	.tp_doc = "StringScanner(min_length, path=None, chunk_size=16 MiB, needles=None): streaming extract_strings over fed chunks or a memory-mapped file.",
+	.tp_basicsize = sizeof(StringScannerObject),
+	.tp_flags = Py_TPFLAGS_DEFAULT,
+	.tp_new = PyType_GenericNew,
+	.tp_init = (initproc)StringScanner_init,
+	.tp_dealloc = (destructor)StringScanner_dealloc,
+	.tp_iter = (getiterfunc)StringScanner_iter,
+	.tp_iternext = (iternextfunc)StringScanner_iternext,
+	.tp_methods = StringScanner_methods,
+};
+
+static PyObject* stats_get(PyObject* self, PyObject* args, PyObject* kwds) {
+	return native_stats_get_method(&stats, args, kwds);
+}
+
+static PyObject* stats_enable(PyObject* self, PyObject* args, PyObject* kwds) {
+	return native_stats_enable_method(&stats, args, kwds);
+}
+
+static PyObject* stats_reset(PyObject* self, PyObject* unused) {
+	native_stats_reset(&stats);
+	Py_RETURN_NONE;
+}
+
 static PyMethodDef Methods[] = {
-	{"extract_strings", (PyCFunction)extract_strings, METH_VARARGS, "Extract UTF-16LE and UTF-8 printable strings from bytes"},
+	{"extract_strings", (PyCFunction)(void(*)(void))extract_strings, METH_VARARGS | METH_KEYWORDS, "Extract UTF-16LE and UTF-8 printable strings from bytes on `threads` workers (0 = all cores) with the GIL released; needles= keeps only strings containing one of them"},
+	{"extract_string_spans", (PyCFunction)(void(*)(void))extract_string_spans, METH_VARARGS | METH_KEYWORDS, "Scan like extract_strings but return a StringSpans of offset-sorted records with lazy decoding"},
+	{"stats", (PyCFunction)(void(*)(void))stats_get, METH_VARARGS | METH_KEYWORDS, "Return {name: value} phase timers (*_ns) and counters collected while enabled; per_thread=True gives one value per worker slot"},
+	{"reset_stats", (PyCFunction)stats_reset, METH_NOARGS, "Zero the stats() timers and counters"},
+	{"enable_stats", (PyCFunction)(void(*)(void))stats_enable, METH_VARARGS | METH_KEYWORDS, "Turn stats collection on or off (REASY_NATIVE_STATS=1 enables it at import); returns the previous state"},
 	{NULL, NULL, 0, NULL}
 };
 
@@ -153,5 +734,31 @@ static struct PyModuleDef Module = {
 };
 
 PyMODINIT_FUNC PyInit_fast_string_scan(void) {
-	return PyModule_Create(&Module);
+	native_stats_init(&stats);
+	if (PyType_Ready(&StringScannerType) < 0 || PyType_Ready(&StringSpansType) < 0 || PyType_Ready(&StringFilterType) < 0) return NULL;
+	PyObject* m = PyModule_Create(&Module);
+	if (!m) return NULL;
+	Py_INCREF(&StringScannerType);
+	if (PyModule_AddObject(m, "StringScanner", (PyObject*)&StringScannerType) < 0) {
+		Py_DECREF(&StringScannerType);
+		Py_DECREF(m);
+		return NULL;
+	}
+	Py_INCREF(&StringFilterType);
+	if (PyModule_AddObject(m, "StringFilter", (PyObject*)&StringFilterType) < 0) {
+		Py_DECREF(&StringFilterType);
+		Py_DECREF(m);
+		return NULL;
+	}
+	Py_INCREF(&StringSpansType);
+	if (PyModule_AddObject(m, "StringSpans", (PyObject*)&StringSpansType) < 0) {
+		Py_DECREF(&StringSpansType);
+		Py_DECREF(m);
+		return NULL;
+	}
+	if (PyModule_AddIntConstant(m, "ENCODING_UTF16LE", ENCODING_UTF16LE) < 0 || PyModule_AddIntConstant(m, "ENCODING_UTF8", ENCODING_UTF8) < 0) {
+		Py_DECREF(m);
+		return NULL;
+	}
+	return m;
 }
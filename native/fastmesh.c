@@ -1,8 +1,41 @@
 #include <Python.h>
+#include <errno.h>
+#include <limits.h>
 #include <math.h>
 #include <stdint.h>
 #include <string.h>
 
+#include "native_cpu.h"
+#include "native_file.h"
+#include "native_parallel.h"
+#include "native_stats.h"
+
+/* Phase timers (*_ns) and counters behind stats(); see native_stats.h. */
+enum {
+    STAT_ALLOC_NS, STAT_ALLOCATIONS, STAT_ALLOC_BYTES,
+    STAT_UNPACK_NS, STAT_UNPACK_BYTES,
+    STAT_PACK_NS, STAT_PACK_BYTES,
+    STAT_WRITE_NS, STAT_WRITE_BYTES,
+    STAT_DECODE_NS, STAT_DECODE_VERTICES,
+    STAT_GEOMETRY_NS, STAT_GEOMETRY_VERTICES,
+};
+static const char* const stat_names[] = {
+    "alloc_ns", "allocations", "alloc_bytes",
+    "unpack_ns", "unpack_bytes",
+    "pack_ns", "pack_bytes",
+    "write_ns", "write_bytes",
+    "decode_ns", "decode_vertices",
+    "geometry_ns", "geometry_vertices",
+};
+static native_stats stats = NATIVE_STATS_INIT(stat_names);
+
+/* Closes a timed phase started with native_stats_clock on the calling thread. */
+static void stats_phase(int timer, unsigned long long started, int counter, long long amount) {
+    if (!started) return;
+    native_stats_time(&stats, 0, timer, started);
+    native_stats_add(&stats, 0, counter, amount);
+}
+
 static double half_to_float(uint16_t h) {
     char buf[2];
     memcpy(buf, &h, 2);
@@ -17,52 +50,201 @@ static uint16_t float_to_half(double f) {
     return out;
 }
 
-static PyObject* unpack_normals_tangents(PyObject* self, PyObject* args) {
-    Py_buffer view;
-    if (!PyArg_ParseTuple(args, "y*", &view))
-        return NULL;
-    const unsigned char* data = (const unsigned char*)view.buf;
-    Py_ssize_t count = view.len / 8;
+/* Every half as the double PyFloat_Unpack2 returns, so table lookups match the
+ * reference conversion bit for bit (NaNs included). Filled at module init. */
+static double half_table[65536];
 
-    PyObject* array_mod = PyImport_ImportModule("array");
-    if (!array_mod) {
-        PyBuffer_Release(&view);
-        return NULL;
+#define HALF_IS_NAN(h) (((h) & 0x7fff) > 0x7c00)
+
+static void init_half_table(void) {
+    for (int h = 0; h < 65536; ++h)
+        half_table[h] = half_to_float((uint16_t)h);
+}
+
+/* GIL-free port of PyFloat_Pack2's round-half-to-even packing. Returns 0 on
+ * success, -1 on overflow and 1 for NaN; callers hand both back to float_to_half
+ * so the error and NaN encoding stay exactly Python's. */
+static int double_to_half(double x, uint16_t* out) {
+    uint64_t bits;
+    memcpy(&bits, &x, 8);
+    uint16_t sign = (uint16_t)((bits >> 48) & 0x8000);
+    uint64_t magnitude = bits & 0x7fffffffffffffffULL;
+    if (magnitude >= 0x7ff0000000000000ULL) {
+        if (magnitude > 0x7ff0000000000000ULL)
+            return 1;
+        *out = sign | 0x7c00;
+        return 0;
     }
-    PyObject* array_cls = PyObject_GetAttrString(array_mod, "array");
-    Py_DECREF(array_mod);
-    if (!array_cls) {
-        PyBuffer_Release(&view);
-        return NULL;
+    int e = (int)(magnitude >> 52) - 1023;
+    if (e >= 16)
+        return -1;
+    if (e < -25) {
+        *out = sign;
+        return 0;
     }
+    /* 53-bit significand; keep 11 bits for normals, fewer for subnormals */
+    uint64_t m = (magnitude & 0xfffffffffffffULL) | 0x10000000000000ULL;
+    int shift = e >= -14 ? 42 : 28 - e;
+    uint64_t q = m >> shift;
+    uint64_t rem = m & ((1ULL << shift) - 1);
+    uint64_t half = 1ULL << (shift - 1);
+    if (rem > half || (rem == half && (q & 1)))
+        ++q;
+    /* normals: the mantissa carry into bit 10 bumps the exponent, as Pack2 does */
+    uint32_t h = e >= -14 ? ((uint32_t)(e + 14) << 10) + (uint32_t)q : (uint32_t)q;
+    if (h >= 0x7c00)
+        return -1;
+    *out = sign | (uint16_t)h;
+    return 0;
+}
 
-    PyObject* normals_arr = PyObject_CallFunction(array_cls, "s", "f");
-    PyObject* tangents_arr = PyObject_CallFunction(array_cls, "s", "f");
-    PyObject* normal_ws_arr = PyObject_CallFunction(array_cls, "s", "B");
-    PyObject* tangent_ws_arr = PyObject_CallFunction(array_cls, "s", "B");
+#ifdef NATIVE_X86
+/* Flipped UVs (1 - half) from 8 halves at a time; blocks holding a NaN use the table. */
+NATIVE_TARGET("avx,f16c")
+static Py_ssize_t flip_halves_f16c(const uint16_t* src, Py_ssize_t n, double* dst64, float* dst32) {
+    const __m256d one = _mm256_set1_pd(1.0);
+    const __m128i mask = _mm_set1_epi16(0x7fff), inf = _mm_set1_epi16(0x7c00);
+    Py_ssize_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m128i h = _mm_loadu_si128((const __m128i*)(src + i));
+        if (_mm_movemask_epi8(_mm_cmpgt_epi16(_mm_and_si128(h, mask), inf)))
+            return i;
+        __m256 f = _mm256_cvtph_ps(h);
+        __m256d lo = _mm256_sub_pd(one, _mm256_cvtps_pd(_mm256_castps256_ps128(f)));
+        __m256d hi = _mm256_sub_pd(one, _mm256_cvtps_pd(_mm256_extractf128_ps(f, 1)));
+        if (dst64) {
+            _mm256_storeu_pd(dst64 + i, lo);
+            _mm256_storeu_pd(dst64 + i + 4, hi);
+        } else {
+            _mm_storeu_ps(dst32 + i, _mm256_cvtpd_ps(lo));
+            _mm_storeu_ps(dst32 + i + 4, _mm256_cvtpd_ps(hi));
+        }
+    }
+    return i;
+}
+#endif
 
-    PyObject* normals_bytes = PyBytes_FromStringAndSize(NULL, count * 3 * sizeof(float));
-    PyObject* tangents_bytes = PyBytes_FromStringAndSize(NULL, count * 3 * sizeof(float));
-    PyObject* normal_w_bytes = PyBytes_FromStringAndSize(NULL, count);
-    PyObject* tangent_w_bytes = PyBytes_FromStringAndSize(NULL, count);
-    if (!normals_arr || !tangents_arr || !normal_ws_arr || !tangent_ws_arr ||
-        !normals_bytes || !tangents_bytes || !normal_w_bytes || !tangent_w_bytes) {
-        Py_XDECREF(normals_arr); Py_XDECREF(tangents_arr);
-        Py_XDECREF(normal_ws_arr); Py_XDECREF(tangent_ws_arr);
-        Py_XDECREF(normals_bytes); Py_XDECREF(tangents_bytes);
-        Py_XDECREF(normal_w_bytes); Py_XDECREF(tangent_w_bytes);
-        Py_DECREF(array_cls);
-        PyBuffer_Release(&view);
-        return NULL;
+#ifdef NATIVE_NEON
+static Py_ssize_t flip_halves_neon(const uint16_t* src, Py_ssize_t n, double* dst64, float* dst32) {
+    const float64x2_t one = vdupq_n_f64(1.0);
+    Py_ssize_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        uint16x4_t h = vld1_u16(src + i);
+        if (vmaxv_u16(vcgt_u16(vand_u16(h, vdup_n_u16(0x7fff)), vdup_n_u16(0x7c00))))
+            return i;
+        float32x4_t f = vcvt_f32_f16(vreinterpret_f16_u16(h));
+        float64x2_t lo = vsubq_f64(one, vcvt_f64_f32(vget_low_f32(f)));
+        float64x2_t hi = vsubq_f64(one, vcvt_high_f64_f32(f));
+        if (dst64) {
+            vst1q_f64(dst64 + i, lo);
+            vst1q_f64(dst64 + i + 2, hi);
+        } else {
+            vst1q_f32(dst32 + i, vcombine_f32(vcvt_f32_f64(lo), vcvt_f32_f64(hi)));
+        }
     }
+    return i;
+}
+#endif
 
-    float* np = (float*)PyBytes_AsString(normals_bytes);
-    float* tp = (float*)PyBytes_AsString(tangents_bytes);
-    unsigned char* nwp = (unsigned char*)PyBytes_AsString(normal_w_bytes);
-    unsigned char* twp = (unsigned char*)PyBytes_AsString(tangent_w_bytes);
+/* 1 - half for n halves into float64 (dst64) or float32 (dst32) output; the flip
+ * is always done in double precision to avoid losing LSBs. */
+static void flip_halves(const uint16_t* src, Py_ssize_t n, double* dst64, float* dst32) {
+    Py_ssize_t i = 0;
+    while (i < n) {
+#ifdef NATIVE_X86
+        if (native_cpu_features() & NATIVE_CPU_F16C)
+            i += flip_halves_f16c(src + i, n - i, dst64 ? dst64 + i : NULL, dst32 ? dst32 + i : NULL);
+#endif
+#ifdef NATIVE_NEON
+        i += flip_halves_neon(src + i, n - i, dst64 ? dst64 + i : NULL, dst32 ? dst32 + i : NULL);
+#endif
+        /* scalar tail, or one SIMD block holding a NaN */
+        Py_ssize_t stop = i + 8 < n ? i + 8 : n;
+        for (; i < stop; ++i) {
+            double value = 1.0 - half_table[src[i]];
+            if (dst64) dst64[i] = value;
+            else dst32[i] = (float)value;
+        }
+    }
+}
 
-    for (Py_ssize_t i = 0; i < count; ++i) {
+/* array.array, cached at module init. */
+static PyObject* array_type = NULL;
+
+/* Creates an array of count zeroed items and points *data at its storage. */
+static PyObject* new_array(const char* typecode, Py_ssize_t count, void** data) {
+    unsigned long long started = native_stats_clock(&stats);
+    PyObject* unit = PyObject_CallFunction(array_type, "s(i)", typecode, 0);
+    if (!unit) return NULL;
+    PyObject* arr = PySequence_Repeat(unit, count);
+    Py_DECREF(unit);
+    if (!arr) return NULL;
+    Py_buffer view;
+    if (PyObject_GetBuffer(arr, &view, PyBUF_WRITABLE) != 0) { Py_DECREF(arr); return NULL; }
+    *data = view.buf;
+    if (started) native_stats_add(&stats, 0, STAT_ALLOCATIONS, 1);
+    stats_phase(STAT_ALLOC_NS, started, STAT_ALLOC_BYTES, view.len);
+    PyBuffer_Release(&view);
+    return arr;
+}
+
+static uint16_t load_u16(const unsigned char* p) {
+    uint16_t value;
+    memcpy(&value, p, 2);
+    return value;
+}
+
+static uint32_t load_u32(const unsigned char* p) {
+    uint32_t value;
+    memcpy(&value, p, 4);
+    return value;
+}
+
+/* Acquires a writable contiguous caller buffer holding at least need bytes. */
+static int get_out_buffer(PyObject* obj, Py_ssize_t need, Py_buffer* view) {
+    if (PyObject_GetBuffer(obj, view, PyBUF_WRITABLE | PyBUF_C_CONTIGUOUS) < 0)
+        return -1;
+    if (view->len < need) {
+        PyErr_Format(PyExc_ValueError, "out buffer too small: need %zd bytes, got %zd", need, view->len);
+        PyBuffer_Release(view);
+        return -1;
+    }
+    return 0;
+}
+
+/* snorm8 normal/tangent records: 8 bytes per vertex, normal xyz + w then tangent
+ * xyz + w. xyz decode as byte / 127 (a true division, so every path matches the
+ * scalar loop) and w stays a raw byte, or decodes like xyz in xyzw mode. */
+
+static inline unsigned char quantize_snorm8(float x) {
+    float y = x * 127.0f;
+    /* saturate instead of wrapping; -128 stays reachable so raw bytes round-trip */
+    if (y != y) y = 0.0f;
+    if (y < -128.0f) y = -128.0f;
+    if (y > 127.0f) y = 127.0f;
+    return (unsigned char)(signed char)lroundf(y);
+}
+
+static void renormalize3(float* v) {
+    float len = sqrtf(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+    if (len > 0.0f) {
+        v[0] /= len;
+        v[1] /= len;
+        v[2] /= len;
+    }
+}
+
+static void snorm8_decode_scalar(const unsigned char* data, Py_ssize_t begin, Py_ssize_t end,
+                                 float* np, unsigned char* nwp, float* tp, unsigned char* twp, int xyzw) {
+    for (Py_ssize_t i = begin; i < end; ++i) {
         const signed char* p = (const signed char*)(data + i * 8);
+        if (xyzw) {
+            for (int c = 0; c < 4; ++c) {
+                np[i * 4 + c] = p[c] / 127.0f;
+                tp[i * 4 + c] = p[4 + c] / 127.0f;
+            }
+            continue;
+        }
         np[i * 3 + 0] = p[0] / 127.0f;
         np[i * 3 + 1] = p[1] / 127.0f;
         np[i * 3 + 2] = p[2] / 127.0f;
@@ -72,159 +254,1924 @@ static PyObject* unpack_normals_tangents(PyObject* self, PyObject* args) {
         tp[i * 3 + 2] = p[6] / 127.0f;
         twp[i] = (unsigned char)p[7];
     }
+}
 
-    PyObject_CallMethod(normals_arr, "frombytes", "O", normals_bytes);
-    PyObject_CallMethod(tangents_arr, "frombytes", "O", tangents_bytes);
-    PyObject_CallMethod(normal_ws_arr, "frombytes", "O", normal_w_bytes);
-    PyObject_CallMethod(tangent_ws_arr, "frombytes", "O", tangent_w_bytes);
+static void snorm8_encode_scalar(unsigned char* out, Py_ssize_t begin, Py_ssize_t end, const float* np, const unsigned char* nwp,
+                                 const float* tp, const unsigned char* twp, int xyzw, int renormalize) {
+    const int width = xyzw ? 4 : 3;
+    for (Py_ssize_t i = begin; i < end; ++i) {
+        float n[4], t[4];
+        memcpy(n, np + i * width, (size_t)width * sizeof(float));
+        memcpy(t, tp + i * width, (size_t)width * sizeof(float));
+        if (renormalize) {
+            renormalize3(n);
+            renormalize3(t);
+        }
+        for (int c = 0; c < 3; ++c) {
+            out[i * 8 + c] = quantize_snorm8(n[c]);
+            out[i * 8 + 4 + c] = quantize_snorm8(t[c]);
+        }
+        out[i * 8 + 3] = xyzw ? quantize_snorm8(n[3]) : nwp[i];
+        out[i * 8 + 7] = xyzw ? quantize_snorm8(t[3]) : twp[i];
+    }
+}
 
-    Py_DECREF(normals_bytes); Py_DECREF(tangents_bytes);
-    Py_DECREF(normal_w_bytes); Py_DECREF(tangent_w_bytes);
-    Py_DECREF(array_cls);
-    PyBuffer_Release(&view);
+#ifdef NATIVE_X86
+/* xyz mode stores four floats per vector, so the last record is left to the scalar tail. */
+NATIVE_TARGET("avx2")
+static Py_ssize_t snorm8_decode_avx2(const unsigned char* data, Py_ssize_t count,
+                                     float* np, unsigned char* nwp, float* tp, unsigned char* twp, int xyzw) {
+    const __m256 scale = _mm256_set1_ps(127.0f);
+    const int width = xyzw ? 4 : 3;
+    Py_ssize_t i = 0;
+    for (; i + 2 + (xyzw ? 0 : 1) <= count; i += 2) {
+        __m128i raw = _mm_loadu_si128((const __m128i*)(data + i * 8));
+        __m256 a = _mm256_div_ps(_mm256_cvtepi32_ps(_mm256_cvtepi8_epi32(raw)), scale);
+        __m256 b = _mm256_div_ps(_mm256_cvtepi32_ps(_mm256_cvtepi8_epi32(_mm_srli_si128(raw, 8))), scale);
+        _mm_storeu_ps(np + i * width, _mm256_castps256_ps128(a));
+        _mm_storeu_ps(tp + i * width, _mm256_extractf128_ps(a, 1));
+        _mm_storeu_ps(np + (i + 1) * width, _mm256_castps256_ps128(b));
+        _mm_storeu_ps(tp + (i + 1) * width, _mm256_extractf128_ps(b, 1));
+        if (!xyzw) {
+            nwp[i] = data[i * 8 + 3]; twp[i] = data[i * 8 + 7];
+            nwp[i + 1] = data[i * 8 + 11]; twp[i + 1] = data[i * 8 + 15];
+        }
+    }
+    return i;
+}
 
-    return Py_BuildValue("(OOOO)", normals_arr, normal_ws_arr, tangents_arr, tangent_ws_arr);
+NATIVE_TARGET("sse4.1")
+static Py_ssize_t snorm8_decode_sse41(const unsigned char* data, Py_ssize_t count,
+                                      float* np, unsigned char* nwp, float* tp, unsigned char* twp, int xyzw) {
+    const __m128 scale = _mm_set1_ps(127.0f);
+    const int width = xyzw ? 4 : 3;
+    Py_ssize_t i = 0;
+    for (; i + 1 + (xyzw ? 0 : 1) <= count; ++i) {
+        __m128i raw = _mm_loadl_epi64((const __m128i*)(data + i * 8));
+        _mm_storeu_ps(np + i * width, _mm_div_ps(_mm_cvtepi32_ps(_mm_cvtepi8_epi32(raw)), scale));
+        _mm_storeu_ps(tp + i * width, _mm_div_ps(_mm_cvtepi32_ps(_mm_cvtepi8_epi32(_mm_srli_si128(raw, 4))), scale));
+        if (!xyzw) {
+            nwp[i] = data[i * 8 + 3];
+            twp[i] = data[i * 8 + 7];
+        }
+    }
+    return i;
+}
+
+/* Same steps as quantize_snorm8: scale, NaN to 0, clamp, round half away from zero. */
+NATIVE_TARGET("sse4.1")
+static inline __m128i quantize_snorm8_sse41(__m128 x) {
+    const __m128 one = _mm_set1_ps(1.0f), half = _mm_set1_ps(0.5f);
+    __m128 y = _mm_mul_ps(x, _mm_set1_ps(127.0f));
+    y = _mm_and_ps(y, _mm_cmpord_ps(y, y));
+    y = _mm_min_ps(_mm_max_ps(y, _mm_set1_ps(-128.0f)), _mm_set1_ps(127.0f));
+    __m128 t = _mm_round_ps(y, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
+    __m128 frac = _mm_sub_ps(y, t);
+    t = _mm_add_ps(t, _mm_and_ps(_mm_cmpge_ps(frac, half), one));
+    t = _mm_sub_ps(t, _mm_and_ps(_mm_cmple_ps(frac, _mm_sub_ps(_mm_setzero_ps(), half)), one));
+    return _mm_cvttps_epi32(t);
+}
+
+NATIVE_TARGET("sse4.1")
+static Py_ssize_t snorm8_encode_sse41(unsigned char* out, Py_ssize_t count, const float* np, const unsigned char* nwp,
+                                      const float* tp, const unsigned char* twp, int xyzw) {
+    const int width = xyzw ? 4 : 3;
+    Py_ssize_t i = 0;
+    for (; i + 1 + (xyzw ? 0 : 1) <= count; ++i) {
+        __m128i n = quantize_snorm8_sse41(_mm_loadu_ps(np + i * width));
+        __m128i t = quantize_snorm8_sse41(_mm_loadu_ps(tp + i * width));
+        __m128i bytes = _mm_packs_epi16(_mm_packs_epi32(n, t), _mm_setzero_si128());
+        _mm_storel_epi64((__m128i*)(out + i * 8), bytes);
+        if (!xyzw) {
+            out[i * 8 + 3] = nwp[i];
+            out[i * 8 + 7] = twp[i];
+        }
+    }
+    return i;
 }
+#endif
 
-static PyObject* pack_normals_tangents(PyObject* self, PyObject* args) {
-    PyObject *normals_obj, *normal_ws_obj, *tangents_obj, *tangent_ws_obj;
-    if (!PyArg_ParseTuple(args, "OOOO", &normals_obj, &normal_ws_obj, &tangents_obj, &tangent_ws_obj))
+#ifdef NATIVE_NEON
+static Py_ssize_t snorm8_decode_neon(const unsigned char* data, Py_ssize_t count,
+                                     float* np, unsigned char* nwp, float* tp, unsigned char* twp, int xyzw) {
+    const float32x4_t scale = vdupq_n_f32(127.0f);
+    const int width = xyzw ? 4 : 3;
+    Py_ssize_t i = 0;
+    for (; i + 1 + (xyzw ? 0 : 1) <= count; ++i) {
+        int16x8_t wide = vmovl_s8(vld1_s8((const int8_t*)(data + i * 8)));
+        vst1q_f32(np + i * width, vdivq_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(wide))), scale));
+        vst1q_f32(tp + i * width, vdivq_f32(vcvtq_f32_s32(vmovl_high_s16(wide)), scale));
+        if (!xyzw) {
+            nwp[i] = data[i * 8 + 3];
+            twp[i] = data[i * 8 + 7];
+        }
+    }
+    return i;
+}
+
+static inline int32x4_t quantize_snorm8_neon(float32x4_t x) {
+    const float32x4_t one = vdupq_n_f32(1.0f);
+    float32x4_t y = vmulq_n_f32(x, 127.0f);
+    y = vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(y), vceqq_f32(y, y)));
+    y = vminq_f32(vmaxq_f32(y, vdupq_n_f32(-128.0f)), vdupq_n_f32(127.0f));
+    float32x4_t t = vrndq_f32(y);
+    float32x4_t frac = vsubq_f32(y, t);
+    t = vaddq_f32(t, vreinterpretq_f32_u32(vandq_u32(vcgeq_f32(frac, vdupq_n_f32(0.5f)), vreinterpretq_u32_f32(one))));
+    t = vsubq_f32(t, vreinterpretq_f32_u32(vandq_u32(vcleq_f32(frac, vdupq_n_f32(-0.5f)), vreinterpretq_u32_f32(one))));
+    return vcvtq_s32_f32(t);
+}
+
+static Py_ssize_t snorm8_encode_neon(unsigned char* out, Py_ssize_t count, const float* np, const unsigned char* nwp,
+                                     const float* tp, const unsigned char* twp, int xyzw) {
+    const int width = xyzw ? 4 : 3;
+    Py_ssize_t i = 0;
+    for (; i + 1 + (xyzw ? 0 : 1) <= count; ++i) {
+        int16x8_t both = vcombine_s16(vqmovn_s32(quantize_snorm8_neon(vld1q_f32(np + i * width))),
+                                      vqmovn_s32(quantize_snorm8_neon(vld1q_f32(tp + i * width))));
+        vst1_s8((int8_t*)(out + i * 8), vqmovn_s16(both));
+        if (!xyzw) {
+            out[i * 8 + 3] = nwp[i];
+            out[i * 8 + 7] = twp[i];
+        }
+    }
+    return i;
+}
+#endif
+
+/* GIL-free entry points used by the unpack/pack wrappers. */
+static void snorm8_decode(const unsigned char* data, Py_ssize_t count,
+                          float* np, unsigned char* nwp, float* tp, unsigned char* twp, int xyzw) {
+    Py_ssize_t done = 0;
+#ifdef NATIVE_X86
+    int features = native_cpu_features();
+    if (features & NATIVE_CPU_AVX2)
+        done = snorm8_decode_avx2(data, count, np, nwp, tp, twp, xyzw);
+    else if (features & NATIVE_CPU_SSE41)
+        done = snorm8_decode_sse41(data, count, np, nwp, tp, twp, xyzw);
+#endif
+#ifdef NATIVE_NEON
+    done = snorm8_decode_neon(data, count, np, nwp, tp, twp, xyzw);
+#endif
+    snorm8_decode_scalar(data, done, count, np, nwp, tp, twp, xyzw);
+}
+
+/* Renormalizing goes through the scalar loop so every build rounds it the same way. */
+static void snorm8_encode(unsigned char* out, Py_ssize_t count, const float* np, const unsigned char* nwp,
+                          const float* tp, const unsigned char* twp, int xyzw, int renormalize) {
+    Py_ssize_t done = 0;
+    if (!renormalize) {
+#ifdef NATIVE_X86
+        if (native_cpu_features() & NATIVE_CPU_SSE41)
+            done = snorm8_encode_sse41(out, count, np, nwp, tp, twp, xyzw);
+#endif
+#ifdef NATIVE_NEON
+        done = snorm8_encode_neon(out, count, np, nwp, tp, twp, xyzw);
+#endif
+    }
+    snorm8_encode_scalar(out, done, count, np, nwp, tp, twp, xyzw, renormalize);
+}
+
+static PyObject* unpack_normals_tangents(PyObject* self, PyObject* args, PyObject* kwargs) {
+    static char* kwlist[] = {"data", "out", "xyzw", NULL};
+    Py_buffer view;
+    PyObject* out_obj = Py_None;
+    int xyzw = 0;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "y*|Op", kwlist, &view, &out_obj, &xyzw))
         return NULL;
+    const unsigned char* data = (const unsigned char*)view.buf;
+    Py_ssize_t count = view.len / 8;
 
-    Py_buffer normals, normal_ws, tangents, tangent_ws;
-    if (PyObject_GetBuffer(normals_obj, &normals, PyBUF_SIMPLE) < 0) return NULL;
-    if (PyObject_GetBuffer(normal_ws_obj, &normal_ws, PyBUF_SIMPLE) < 0) {
-        PyBuffer_Release(&normals); return NULL; }
-    if (PyObject_GetBuffer(tangents_obj, &tangents, PyBUF_SIMPLE) < 0) {
-        PyBuffer_Release(&normals); PyBuffer_Release(&normal_ws); return NULL; }
-    if (PyObject_GetBuffer(tangent_ws_obj, &tangent_ws, PyBUF_SIMPLE) < 0) {
-        PyBuffer_Release(&normals); PyBuffer_Release(&normal_ws); PyBuffer_Release(&tangents); return NULL; }
+    /* outputs: normals (3 floats), normal w (1 byte), tangents (3 floats), tangent w (1 byte);
+     * xyzw mode returns only normals and tangents, 4 floats each */
+    const int outputs = xyzw ? 2 : 4;
+    const Py_ssize_t floats = count * (xyzw ? 4 : 3);
+    const Py_ssize_t sizes[4] = {floats * (Py_ssize_t)sizeof(float), count, floats * (Py_ssize_t)sizeof(float), count};
+    static const char* typecodes[4] = {"f", "B", "f", "B"};
+    const int slots[4] = {0, xyzw ? 2 : 1, 2, 3};
+    PyObject* result;
+    void* bufs[4] = {NULL, NULL, NULL, NULL};
+    Py_buffer outs[4];
+    int held = 0;
+    if (out_obj == Py_None) {
+        result = PyTuple_New(outputs);
+        if (!result) { PyBuffer_Release(&view); return NULL; }
+        for (int k = 0; k < outputs; ++k) {
+            int slot = slots[k];
+            PyObject* arr = new_array(typecodes[slot], slot == 0 || slot == 2 ? floats : count, &bufs[slot]);
+            if (!arr) { Py_DECREF(result); PyBuffer_Release(&view); return NULL; }
+            PyTuple_SET_ITEM(result, k, arr);
+        }
+    } else {
+        if (!PyTuple_Check(out_obj) || PyTuple_GET_SIZE(out_obj) != outputs) {
+            PyErr_SetString(PyExc_TypeError, xyzw
+                ? "out must be a (normals, tangents) tuple of writable buffers"
+                : "out must be a (normals, normal_ws, tangents, tangent_ws) tuple of writable buffers");
+            PyBuffer_Release(&view);
+            return NULL;
+        }
+        for (; held < outputs; ++held) {
+            int slot = slots[held];
+            if (get_out_buffer(PyTuple_GET_ITEM(out_obj, held), sizes[slot], &outs[held]) < 0)
+                break;
+            bufs[slot] = outs[held].buf;
+        }
+        if (held < outputs) {
+            while (held > 0) PyBuffer_Release(&outs[--held]);
+            PyBuffer_Release(&view);
+            return NULL;
+        }
+        Py_INCREF(out_obj);
+        result = out_obj;
+    }
 
-    Py_ssize_t count = normals.len / (3 * sizeof(float));
-    PyObject* bytes = PyBytes_FromStringAndSize(NULL, count * 8);
-    if (!bytes) {
-        PyBuffer_Release(&normals); PyBuffer_Release(&normal_ws);
-        PyBuffer_Release(&tangents); PyBuffer_Release(&tangent_ws);
+    unsigned long long started = native_stats_clock(&stats);
+    snorm8_decode(data, count, (float*)bufs[0], (unsigned char*)bufs[1], (float*)bufs[2], (unsigned char*)bufs[3], xyzw);
+    stats_phase(STAT_UNPACK_NS, started, STAT_UNPACK_BYTES, count * 8);
+
+    while (held > 0) PyBuffer_Release(&outs[--held]);
+    PyBuffer_Release(&view);
+    return result;
+}
+
+static PyObject* unpack_uvs(PyObject* self, PyObject* args, PyObject* kwargs) {
+    static char* kwlist[] = {"data", "out", "float32", NULL};
+    Py_buffer view;
+    PyObject* out_obj = Py_None;
+    int float32 = 0;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "y*|Op", kwlist, &view, &out_obj, &float32))
         return NULL;
+    Py_ssize_t count = view.len / 4;
+    Py_ssize_t itemsize = float32 ? (Py_ssize_t)sizeof(float) : (Py_ssize_t)sizeof(double);
+
+    Py_buffer out_view;
+    PyObject* result;
+    void* out;
+    if (out_obj == Py_None) {
+        result = new_array(float32 ? "f" : "d", count * 2, &out);
+        if (!result) { PyBuffer_Release(&view); return NULL; }
+    } else {
+        if (get_out_buffer(out_obj, count * 2 * itemsize, &out_view) < 0) {
+            PyBuffer_Release(&view);
+            return NULL;
+        }
+        out = out_view.buf;
+        Py_INCREF(out_obj);
+        result = out_obj;
     }
-    unsigned char* buf = (unsigned char*)PyBytes_AsString(bytes);
-    const float* np = (const float*)normals.buf;
-    const float* tp = (const float*)tangents.buf;
-    const unsigned char* nwp = (const unsigned char*)normal_ws.buf;
-    const unsigned char* twp = (const unsigned char*)tangent_ws.buf;
+    unsigned long long started = native_stats_clock(&stats);
+    flip_halves((const uint16_t*)view.buf, count * 2, float32 ? NULL : (double*)out, float32 ? (float*)out : NULL);
+    stats_phase(STAT_UNPACK_NS, started, STAT_UNPACK_BYTES, count * 4);
+    if (out_obj != Py_None) PyBuffer_Release(&out_view);
+    PyBuffer_Release(&view);
+    return result;
+}
 
-    for (Py_ssize_t i = 0; i < count; ++i) {
-        buf[i*8 + 0] = (unsigned char)lroundf(np[i*3 + 0] * 127.0f);
-        buf[i*8 + 1] = (unsigned char)lroundf(np[i*3 + 1] * 127.0f);
-        buf[i*8 + 2] = (unsigned char)lroundf(np[i*3 + 2] * 127.0f);
-        buf[i*8 + 3] = nwp[i];
-        buf[i*8 + 4] = (unsigned char)lroundf(tp[i*3 + 0] * 127.0f);
-        buf[i*8 + 5] = (unsigned char)lroundf(tp[i*3 + 1] * 127.0f);
-        buf[i*8 + 6] = (unsigned char)lroundf(tp[i*3 + 2] * 127.0f);
-        buf[i*8 + 7] = twp[i];
-    }
-
-    PyBuffer_Release(&normals); PyBuffer_Release(&normal_ws);
-    PyBuffer_Release(&tangents); PyBuffer_Release(&tangent_ws);
-    return bytes;
+static PyObject* unpack_colors(PyObject* self, PyObject* args, PyObject* kwargs) {
+    static char* kwlist[] = {"data", "out", NULL};
+    Py_buffer view;
+    PyObject* out_obj = Py_None;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "y*|O", kwlist, &view, &out_obj))
+        return NULL;
+    PyObject* result;
+    unsigned long long started = native_stats_clock(&stats);
+    if (out_obj == Py_None) {
+        void* out;
+        result = new_array("B", view.len, &out);
+        if (result && view.len) memcpy(out, view.buf, (size_t)view.len);
+    } else {
+        Py_buffer out_view;
+        result = NULL;
+        if (get_out_buffer(out_obj, view.len, &out_view) == 0) {
+            if (view.len) memmove(out_view.buf, view.buf, (size_t)view.len);
+            PyBuffer_Release(&out_view);
+            Py_INCREF(out_obj);
+            result = out_obj;
+        }
+    }
+    stats_phase(STAT_UNPACK_NS, started, STAT_UNPACK_BYTES, view.len);
+    PyBuffer_Release(&view);
+    return result;
 }
 
+/* Skin weights and index buffers. A weight record holds `bones` bone indices
+ * (uint8) followed by as many unorm8 weights; 8 is the current RE Engine layout. */
+
+#define MAX_BONES 16
 
-static PyObject* unpack_uvs(PyObject* self, PyObject* args) {
+static void quantize_weights(const float* weights, int bones, int normalize, unsigned char* out) {
+    int sum = 0, largest = 0;
+    for (int b = 0; b < bones; ++b) {
+        float y = weights[b] * 255.0f;
+        if (y != y || y < 0.0f) y = 0.0f;
+        if (y > 255.0f) y = 255.0f;
+        out[b] = (unsigned char)lroundf(y);
+        sum += out[b];
+        if (weights[b] > weights[largest]) largest = b;
+    }
+    /* put the rounding residue on the heaviest influence so the vertex sums to 1 */
+    if (normalize && sum > 0 && sum != 255) {
+        int fixed = out[largest] + 255 - sum;
+        out[largest] = (unsigned char)(fixed < 0 ? 0 : fixed > 255 ? 255 : fixed);
+    }
+}
+
+static int check_index_size(int index_size) {
+    if (index_size != 2 && index_size != 4) {
+        PyErr_SetString(PyExc_ValueError, "index_size must be 2 or 4");
+        return -1;
+    }
+    return 0;
+}
+
+/* Signedness of an integer buffer from its struct format; -1 with an error for
+ * anything that is not a native or little-endian integer code. */
+static int index_format_signed(const Py_buffer* view) {
+    const char* format = view->format ? view->format : "B";
+    if (*format == '@' || *format == '=' || *format == '<') ++format;
+    if (format[0] && !format[1] && strchr("bhilqn", format[0]) && view->itemsize <= 8) return 1;
+    if (format[0] && !format[1] && strchr("BHILQN", format[0]) && view->itemsize <= 8) return 0;
+    PyErr_Format(PyExc_TypeError, "indices must be an integer buffer, not format '%s'", view->format ? view->format : "B");
+    return -1;
+}
+
+/* Item i as an unsigned value; negative items map past any index limit. */
+static unsigned long long read_index_item(const Py_buffer* view, int is_signed, Py_ssize_t i) {
+    const unsigned char* p = (const unsigned char*)view->buf + i * view->itemsize;
+    unsigned long long value = 0;
+    memcpy(&value, p, (size_t)view->itemsize);
+    if (is_signed && view->itemsize < 8 && (p[view->itemsize - 1] & 0x80))
+        return ULLONG_MAX;
+    if (is_signed && view->itemsize == 8 && (long long)value < 0)
+        return ULLONG_MAX;
+    return value;
+}
+
+static PyObject* unpack_weights(PyObject* self, PyObject* args, PyObject* kwargs) {
+    static char* kwlist[] = {"data", "bones", "out", NULL};
     Py_buffer view;
-    if (!PyArg_ParseTuple(args, "y*", &view))
+    int bones = 8;
+    PyObject* out_obj = Py_None;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "y*|iO", kwlist, &view, &bones, &out_obj))
         return NULL;
-    Py_ssize_t count = view.len / 4;
-    const unsigned short* data = (const unsigned short*)view.buf;
-
-    PyObject* array_mod = PyImport_ImportModule("array");
-    if (!array_mod) { PyBuffer_Release(&view); return NULL; }
-    PyObject* array_cls = PyObject_GetAttrString(array_mod, "array");
-    Py_DECREF(array_mod);
-    if (!array_cls) { PyBuffer_Release(&view); return NULL; }
-    PyObject* arr = PyObject_CallFunction(array_cls, "s", "d");
-    Py_DECREF(array_cls);
-    if (!arr) { PyBuffer_Release(&view); return NULL; }
-
-    PyObject* bytes = PyBytes_FromStringAndSize(NULL, count * 2 * sizeof(double));
-    if (!bytes) { Py_DECREF(arr); PyBuffer_Release(&view); return NULL; }
-    double* out = (double*)PyBytes_AsString(bytes);
+    if (bones < 1 || bones > MAX_BONES) {
+        PyErr_Format(PyExc_ValueError, "bones must be between 1 and %d", MAX_BONES);
+        PyBuffer_Release(&view);
+        return NULL;
+    }
+    Py_ssize_t count = view.len / (2 * bones);
+    Py_ssize_t items = count * bones;
+
+    /* outputs: bone indices (uint8) and weights (float) */
+    PyObject* result;
+    void* bufs[2];
+    Py_buffer outs[2];
+    int held = 0;
+    if (out_obj == Py_None) {
+        PyObject* ids = new_array("B", items, &bufs[0]);
+        PyObject* weights = ids ? new_array("f", items, &bufs[1]) : NULL;
+        result = weights ? PyTuple_Pack(2, ids, weights) : NULL;
+        Py_XDECREF(ids);
+        Py_XDECREF(weights);
+        if (!result) { PyBuffer_Release(&view); return NULL; }
+    } else {
+        if (!PyTuple_Check(out_obj) || PyTuple_GET_SIZE(out_obj) != 2) {
+            PyErr_SetString(PyExc_TypeError, "out must be an (indices, weights) tuple of writable buffers");
+            PyBuffer_Release(&view);
+            return NULL;
+        }
+        for (; held < 2; ++held) {
+            if (get_out_buffer(PyTuple_GET_ITEM(out_obj, held), held ? items * (Py_ssize_t)sizeof(float) : items, &outs[held]) < 0)
+                break;
+            bufs[held] = outs[held].buf;
+        }
+        if (held < 2) {
+            while (held > 0) PyBuffer_Release(&outs[--held]);
+            PyBuffer_Release(&view);
+            return NULL;
+        }
+        Py_INCREF(out_obj);
+        result = out_obj;
+    }
+
+    const unsigned char* data = (const unsigned char*)view.buf;
+    unsigned char* ids = (unsigned char*)bufs[0];
+    float* weights = (float*)bufs[1];
+    unsigned long long started = native_stats_clock(&stats);
     for (Py_ssize_t i = 0; i < count; ++i) {
-        double u = half_to_float(data[i*2 + 0]);
-        double v = half_to_float(data[i*2 + 1]);
-        /* perform UV flip using double precision to avoid losing LSBs */
-        out[i*2 + 0] = 1.0 - u;
-        out[i*2 + 1] = 1.0 - v;
-    }
-    PyObject_CallMethod(arr, "frombytes", "O", bytes);
-    Py_DECREF(bytes);
+        const unsigned char* rec = data + i * 2 * bones;
+        memcpy(ids + i * bones, rec, (size_t)bones);
+        for (int b = 0; b < bones; ++b)
+            weights[i * bones + b] = rec[bones + b] / 255.0f;
+    }
+    stats_phase(STAT_UNPACK_NS, started, STAT_UNPACK_BYTES, count * 2 * bones);
+
+    while (held > 0) PyBuffer_Release(&outs[--held]);
     PyBuffer_Release(&view);
-    return arr;
+    return result;
 }
 
-static PyObject* pack_uvs(PyObject* self, PyObject* args) {
-    PyObject* arr_obj;
-    if (!PyArg_ParseTuple(args, "O", &arr_obj))
+/* Index output as array('H') or array('I'), or a caller buffer of that width. */
+static PyObject* new_index_output(PyObject* out_obj, int index_size, Py_ssize_t count, Py_buffer* out_view, void** data) {
+    if (out_obj == Py_None)
+        return new_array(index_size == 2 ? "H" : "I", count, data);
+    if (get_out_buffer(out_obj, count * index_size, out_view) < 0)
         return NULL;
+    *data = out_view->buf;
+    Py_INCREF(out_obj);
+    return out_obj;
+}
+
+static PyObject* unpack_indices(PyObject* self, PyObject* args, PyObject* kwargs) {
+    static char* kwlist[] = {"data", "index_size", "base", "out", NULL};
     Py_buffer view;
-    if (PyObject_GetBuffer(arr_obj, &view, PyBUF_SIMPLE) < 0)
+    int index_size = 2;
+    long long base = 0;
+    PyObject* out_obj = Py_None;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "y*|iLO", kwlist, &view, &index_size, &base, &out_obj))
+        return NULL;
+    if (check_index_size(index_size) < 0) { PyBuffer_Release(&view); return NULL; }
+    Py_ssize_t count = view.len / index_size;
+    const long long limit = index_size == 2 ? 0xffffLL : 0xffffffffLL;
+    if (base < -limit || base > limit) {
+        PyErr_SetString(PyExc_OverflowError, "base is out of range for the index size");
+        PyBuffer_Release(&view);
         return NULL;
-    Py_ssize_t count = view.len / (2 * sizeof(double));
-    PyObject* bytes = PyBytes_FromStringAndSize(NULL, count * 4);
-    if (!bytes) { PyBuffer_Release(&view); return NULL; }
-    unsigned short* out = (unsigned short*)PyBytes_AsString(bytes);
-    const double* f = (const double*)view.buf;
+    }
+
+    Py_buffer out_view;
+    void* dst;
+    PyObject* result = new_index_output(out_obj, index_size, count, &out_view, &dst);
+    if (!result) { PyBuffer_Release(&view); return NULL; }
+    const unsigned char* src = (const unsigned char*)view.buf;
+    unsigned long long started = native_stats_clock(&stats);
     for (Py_ssize_t i = 0; i < count; ++i) {
-        double u = f[i*2 + 0];
-        double v = f[i*2 + 1];
-        u = 1.0 - u;
-        v = 1.0 - v;
-        out[i*2 + 0] = float_to_half(u);
-        out[i*2 + 1] = float_to_half(v);
+        long long value = index_size == 2 ? (long long)load_u16(src + i * 2) : (long long)load_u32(src + i * 4);
+        value += base;
+        if (value < 0 || value > limit) {
+            PyErr_Format(PyExc_OverflowError, "index %zd plus base does not fit in %d bytes", i, index_size);
+            Py_CLEAR(result);
+            break;
+        }
+        if (index_size == 2) ((uint16_t*)dst)[i] = (uint16_t)value;
+        else ((uint32_t*)dst)[i] = (uint32_t)value;
     }
+    stats_phase(STAT_UNPACK_NS, started, STAT_UNPACK_BYTES, count * index_size);
+    if (out_obj != Py_None) PyBuffer_Release(&out_view);
     PyBuffer_Release(&view);
-    return bytes;
+    return result;
 }
 
-static PyObject* unpack_colors(PyObject* self, PyObject* args) {
+/* Walks a strip and writes its triangles to dst (or only counts them when dst
+ * is NULL): odd triangles swap their last two indices to keep the winding,
+ * degenerate triangles are dropped, and `restart` starts a new strip. */
+static Py_ssize_t strip_emit(const unsigned char* src, Py_ssize_t count, int index_size, long long restart, void* dst) {
+    Py_ssize_t written = 0, run = 0;
+    uint32_t window[3] = {0, 0, 0};
+    for (Py_ssize_t i = 0; i < count; ++i) {
+        uint32_t index = index_size == 2 ? load_u16(src + i * 2) : load_u32(src + i * 4);
+        if ((long long)index == restart) {
+            run = 0;
+            continue;
+        }
+        window[0] = window[1];
+        window[1] = window[2];
+        window[2] = index;
+        if (++run < 3)
+            continue;
+        if (window[0] == window[1] || window[1] == window[2] || window[0] == window[2])
+            continue;
+        if (dst) {
+            uint32_t tri[3] = {window[0], window[1], window[2]};
+            if (run % 2 == 0) {
+                tri[1] = window[2];
+                tri[2] = window[1];
+            }
+            for (int c = 0; c < 3; ++c) {
+                if (index_size == 2) ((uint16_t*)dst)[written * 3 + c] = (uint16_t)tri[c];
+                else ((uint32_t*)dst)[written * 3 + c] = tri[c];
+            }
+        }
+        ++written;
+    }
+    return written;
+}
+
+static PyObject* strip_to_triangles(PyObject* self, PyObject* args, PyObject* kwargs) {
+    static char* kwlist[] = {"data", "index_size", "restart", "out", NULL};
     Py_buffer view;
-    if (!PyArg_ParseTuple(args, "y*", &view))
-        return NULL;
-    PyObject* array_mod = PyImport_ImportModule("array");
-    if (!array_mod) { PyBuffer_Release(&view); return NULL; }
-    PyObject* array_cls = PyObject_GetAttrString(array_mod, "array");
-    Py_DECREF(array_mod);
-    if (!array_cls) { PyBuffer_Release(&view); return NULL; }
-    PyObject* arr = PyObject_CallFunction(array_cls, "s", "B");
-    Py_DECREF(array_cls);
-    if (!arr) { PyBuffer_Release(&view); return NULL; }
-    PyObject* bytes = PyBytes_FromStringAndSize((const char*)view.buf, view.len);
-    if (!bytes) { Py_DECREF(arr); PyBuffer_Release(&view); return NULL; }
-    PyObject_CallMethod(arr, "frombytes", "O", bytes);
-    Py_DECREF(bytes);
+    int index_size = 2;
+    PyObject* restart_obj = Py_None;
+    PyObject* out_obj = Py_None;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "y*|iOO", kwlist, &view, &index_size, &restart_obj, &out_obj))
+        return NULL;
+    if (check_index_size(index_size) < 0) { PyBuffer_Release(&view); return NULL; }
+    Py_ssize_t count = view.len / index_size;
+    const unsigned char* src = (const unsigned char*)view.buf;
+
+    /* restart=None disables restarts, True uses the all-ones index, or give the value */
+    long long restart = -1;
+    if (restart_obj == Py_True) {
+        restart = index_size == 2 ? 0xffffLL : 0xffffffffLL;
+    } else if (restart_obj != Py_None && restart_obj != Py_False) {
+        restart = PyLong_AsLongLong(restart_obj);
+        if (restart == -1 && PyErr_Occurred()) { PyBuffer_Release(&view); return NULL; }
+    }
+
+    Py_buffer out_view;
+    void* dst;
+    unsigned long long started = native_stats_clock(&stats);
+    Py_ssize_t triangles = strip_emit(src, count, index_size, restart, NULL);
+    PyObject* result = new_index_output(out_obj, index_size, triangles * 3, &out_view, &dst);
+    if (result) {
+        strip_emit(src, count, index_size, restart, dst);
+        if (out_obj != Py_None) PyBuffer_Release(&out_view);
+    }
+    stats_phase(STAT_UNPACK_NS, started, STAT_UNPACK_BYTES, count * index_size);
     PyBuffer_Release(&view);
-    return arr;
+    return result;
+}
+
+/* Packing into caller storage. pack_* return new bytes, pack_*_into write at an
+ * offset of a writable buffer (struct.pack_into style), and write_streams places
+ * several streams into one buffer or file. All of them go through pack_stream:
+ * parse and validate the inputs once, then encode any record range on demand. */
+
+enum { PACK_NORMALS_TANGENTS, PACK_UVS, PACK_COPY, PACK_WEIGHTS, PACK_INDICES };
+
+typedef struct {
+    int kind;
+    Py_buffer views[4];
+    int acquired[4];
+    Py_ssize_t count;        /* records */
+    Py_ssize_t record_size;  /* encoded bytes per record */
+    int renormalize;
+    int xyzw;
+    int float32;
+    int bones;               /* weights: influences per vertex */
+    int normalize;           /* weights: make each vertex sum to 255 */
+    int index_size;          /* indices: encoded bytes per index */
+    int index_signed;        /* indices: source item signedness */
+} pack_stream;
+
+static void pack_stream_close(pack_stream* s) {
+    for (int k = 0; k < 4; ++k)
+        if (s->acquired[k]) PyBuffer_Release(&s->views[k]);
+    memset(s->acquired, 0, sizeof(s->acquired));
+}
+
+static int pack_stream_open(pack_stream* s, int kind, PyObject* args, PyObject* kwargs) {
+    static char* nt_kwlist[] = {"normals", "normal_ws", "tangents", "tangent_ws", "renormalize", "xyzw", NULL};
+    static char* uv_kwlist[] = {"uvs", "float32", NULL};
+    static char* copy_kwlist[] = {"data", NULL};
+    static char* weights_kwlist[] = {"indices", "weights", "bones", "normalize", NULL};
+    static char* indices_kwlist[] = {"indices", "index_size", NULL};
+    PyObject* objs[4] = {NULL, NULL, NULL, NULL};
+    memset(s, 0, sizeof(*s));
+    s->kind = kind;
+    int ok;
+    if (kind == PACK_NORMALS_TANGENTS)
+        ok = PyArg_ParseTupleAndKeywords(args, kwargs, "OOOO|pp", nt_kwlist, &objs[0], &objs[1], &objs[2], &objs[3], &s->renormalize, &s->xyzw);
+    else if (kind == PACK_UVS)
+        ok = PyArg_ParseTupleAndKeywords(args, kwargs, "O|p", uv_kwlist, &objs[0], &s->float32);
+    else if (kind == PACK_WEIGHTS) {
+        s->bones = 8;
+        ok = PyArg_ParseTupleAndKeywords(args, kwargs, "OO|ip", weights_kwlist, &objs[0], &objs[1], &s->bones, &s->normalize);
+        if (ok && (s->bones < 1 || s->bones > MAX_BONES)) {
+            PyErr_Format(PyExc_ValueError, "bones must be between 1 and %d", MAX_BONES);
+            return -1;
+        }
+    } else if (kind == PACK_INDICES) {
+        s->index_size = 2;
+        ok = PyArg_ParseTupleAndKeywords(args, kwargs, "O|i", indices_kwlist, &objs[0], &s->index_size);
+        if (ok && check_index_size(s->index_size) < 0)
+            return -1;
+    } else
+        ok = PyArg_ParseTupleAndKeywords(args, kwargs, "O", copy_kwlist, &objs[0]);
+    if (!ok) return -1;
+    if (kind == PACK_NORMALS_TANGENTS && s->xyzw && (objs[1] != Py_None || objs[3] != Py_None)) {
+        PyErr_SetString(PyExc_TypeError, "xyzw packing takes w from the float4 vectors; pass None for normal_ws and tangent_ws");
+        return -1;
+    }
+    for (int k = 0; k < 4; ++k) {
+        if (!objs[k] || (s->xyzw && (k == 1 || k == 3)))
+            continue;
+        int flags = kind == PACK_INDICES ? PyBUF_C_CONTIGUOUS | PyBUF_FORMAT : PyBUF_SIMPLE;
+        if (PyObject_GetBuffer(objs[k], &s->views[k], flags) < 0) {
+            pack_stream_close(s);
+            return -1;
+        }
+        s->acquired[k] = 1;
+    }
+
+    if (kind == PACK_NORMALS_TANGENTS) {
+        const Py_ssize_t width = s->xyzw ? 4 : 3;
+        s->record_size = 8;
+        s->count = s->views[0].len / (width * (Py_ssize_t)sizeof(float));
+        if (s->views[2].len < s->count * width * (Py_ssize_t)sizeof(float)
+            || (!s->xyzw && (s->views[1].len < s->count || s->views[3].len < s->count))) {
+            PyErr_Format(PyExc_ValueError, "normals hold %zd vertices; tangents and w arrays must cover as many", s->count);
+            pack_stream_close(s);
+            return -1;
+        }
+    } else if (kind == PACK_UVS) {
+        s->record_size = 4;
+        s->count = s->views[0].len / (2 * (s->float32 ? (Py_ssize_t)sizeof(float) : (Py_ssize_t)sizeof(double)));
+    } else if (kind == PACK_WEIGHTS) {
+        s->record_size = 2 * s->bones;
+        s->count = s->views[0].len / s->bones;
+        if (s->views[1].len < s->count * s->bones * (Py_ssize_t)sizeof(float)) {
+            PyErr_Format(PyExc_ValueError, "indices hold %zd vertices; weights must cover as many", s->count);
+            pack_stream_close(s);
+            return -1;
+        }
+    } else if (kind == PACK_INDICES) {
+        s->index_signed = index_format_signed(&s->views[0]);
+        if (s->index_signed < 0) {
+            pack_stream_close(s);
+            return -1;
+        }
+        s->record_size = s->index_size;
+        s->count = s->views[0].len / s->views[0].itemsize;
+    } else {
+        s->record_size = 1;
+        s->count = s->views[0].len;
+    }
+    return 0;
+}
+
+static Py_ssize_t pack_stream_size(const pack_stream* s) {
+    return s->count * s->record_size;
+}
+
+/* Encodes records [begin, end) to out; only UV overflow and out-of-range indices
+ * can fail (exception set). */
+static int pack_stream_encode_records(const pack_stream* s, Py_ssize_t begin, Py_ssize_t end, unsigned char* out) {
+    if (s->kind == PACK_NORMALS_TANGENTS) {
+        const Py_ssize_t width = s->xyzw ? 4 : 3;
+        const unsigned char* nwp = s->xyzw ? NULL : (const unsigned char*)s->views[1].buf + begin;
+        const unsigned char* twp = s->xyzw ? NULL : (const unsigned char*)s->views[3].buf + begin;
+        snorm8_encode(out, end - begin, (const float*)s->views[0].buf + begin * width, nwp,
+                      (const float*)s->views[2].buf + begin * width, twp, s->xyzw, s->renormalize);
+    } else if (s->kind == PACK_UVS) {
+        uint16_t* halves = (uint16_t*)out;
+        const double* f64 = (const double*)s->views[0].buf;
+        const float* f32 = (const float*)s->views[0].buf;
+        for (Py_ssize_t i = begin * 2; i < end * 2; ++i) {
+            double value = 1.0 - (s->float32 ? (double)f32[i] : f64[i]);
+            uint16_t h;
+            if (double_to_half(value, &h) != 0) {
+                h = float_to_half(value);
+                if (PyErr_Occurred()) return -1;
+            }
+            memcpy(halves + (i - begin * 2), &h, 2);
+        }
+    } else if (s->kind == PACK_WEIGHTS) {
+        const int bones = s->bones;
+        const unsigned char* ids = (const unsigned char*)s->views[0].buf;
+        const float* weights = (const float*)s->views[1].buf;
+        for (Py_ssize_t i = begin; i < end; ++i) {
+            unsigned char* rec = out + (i - begin) * 2 * bones;
+            memcpy(rec, ids + i * bones, (size_t)bones);
+            quantize_weights(weights + i * bones, bones, s->normalize, rec + bones);
+        }
+    } else if (s->kind == PACK_INDICES) {
+        const unsigned long long limit = s->index_size == 2 ? 0xffffULL : 0xffffffffULL;
+        for (Py_ssize_t i = begin; i < end; ++i) {
+            unsigned long long value = read_index_item(&s->views[0], s->index_signed, i);
+            if (value > limit) {
+                PyErr_Format(PyExc_OverflowError, "index %zd is out of range for %d-byte indices", i, s->index_size);
+                return -1;
+            }
+            if (s->index_size == 2) {
+                uint16_t v16 = (uint16_t)value;
+                memcpy(out + (i - begin) * 2, &v16, 2);
+            } else {
+                uint32_t v32 = (uint32_t)value;
+                memcpy(out + (i - begin) * 4, &v32, 4);
+            }
+        }
+    } else if (end > begin) {
+        memcpy(out, (const unsigned char*)s->views[0].buf + begin, (size_t)(end - begin));
+    }
+    return 0;
+}
+
+static int pack_stream_encode(const pack_stream* s, Py_ssize_t begin, Py_ssize_t end, unsigned char* out) {
+    unsigned long long started = native_stats_clock(&stats);
+    int status = pack_stream_encode_records(s, begin, end, out);
+    stats_phase(STAT_PACK_NS, started, STAT_PACK_BYTES, (end - begin) * s->record_size);
+    return status;
+}
+
+static PyObject* pack_to_bytes(int kind, PyObject* args, PyObject* kwargs) {
+    pack_stream s;
+    if (pack_stream_open(&s, kind, args, kwargs) < 0) return NULL;
+    PyObject* bytes = PyBytes_FromStringAndSize(NULL, pack_stream_size(&s));
+    if (bytes && pack_stream_encode(&s, 0, s.count, (unsigned char*)PyBytes_AS_STRING(bytes)) < 0)
+        Py_CLEAR(bytes);
+    pack_stream_close(&s);
+    return bytes;
+}
+
+/* Writable view of [offset, offset + size) in buffer, checked like struct.pack_into. */
+static int get_pack_target(PyObject* buffer, Py_ssize_t offset, Py_ssize_t size, Py_buffer* view) {
+    if (PyObject_GetBuffer(buffer, view, PyBUF_WRITABLE | PyBUF_C_CONTIGUOUS) < 0)
+        return -1;
+    if (offset < 0) {
+        PyErr_SetString(PyExc_ValueError, "offset must be >= 0");
+        PyBuffer_Release(view);
+        return -1;
+    }
+    if (offset > view->len || view->len - offset < size) {
+        PyErr_Format(PyExc_ValueError, "packing %zd bytes at offset %zd needs a buffer of at least %zd bytes, got %zd",
+                     size, offset, offset + size, view->len);
+        PyBuffer_Release(view);
+        return -1;
+    }
+    return 0;
+}
+
+/* pack_*_into(buffer, offset, *pack args) -> bytes written */
+static PyObject* pack_into(int kind, PyObject* args, PyObject* kwargs) {
+    PyObject* buffer;
+    Py_ssize_t offset;
+    if (PyTuple_GET_SIZE(args) < 2) {
+        PyErr_SetString(PyExc_TypeError, "pack_*_into() takes a buffer and an offset before the pack arguments");
+        return NULL;
+    }
+    buffer = PyTuple_GET_ITEM(args, 0);
+    offset = PyNumber_AsSsize_t(PyTuple_GET_ITEM(args, 1), PyExc_OverflowError);
+    if (offset == -1 && PyErr_Occurred()) return NULL;
+    PyObject* rest = PyTuple_GetSlice(args, 2, PyTuple_GET_SIZE(args));
+    if (!rest) return NULL;
+    pack_stream s;
+    int opened = pack_stream_open(&s, kind, rest, kwargs);
+    Py_DECREF(rest);
+    if (opened < 0) return NULL;
+
+    PyObject* result = NULL;
+    Py_buffer view;
+    Py_ssize_t size = pack_stream_size(&s);
+    if (get_pack_target(buffer, offset, size, &view) == 0) {
+        if (pack_stream_encode(&s, 0, s.count, (unsigned char*)view.buf + offset) == 0)
+            result = PyLong_FromSsize_t(size);
+        PyBuffer_Release(&view);
+    }
+    pack_stream_close(&s);
+    return result;
+}
+
+static PyObject* pack_normals_tangents(PyObject* self, PyObject* args, PyObject* kwargs) {
+    return pack_to_bytes(PACK_NORMALS_TANGENTS, args, kwargs);
+}
+
+static PyObject* pack_uvs(PyObject* self, PyObject* args, PyObject* kwargs) {
+    return pack_to_bytes(PACK_UVS, args, kwargs);
+}
+
+static PyObject* pack_colors(PyObject* self, PyObject* args, PyObject* kwargs) {
+    return pack_to_bytes(PACK_COPY, args, kwargs);
+}
+
+static PyObject* pack_weights(PyObject* self, PyObject* args, PyObject* kwargs) {
+    return pack_to_bytes(PACK_WEIGHTS, args, kwargs);
+}
+
+static PyObject* pack_indices(PyObject* self, PyObject* args, PyObject* kwargs) {
+    return pack_to_bytes(PACK_INDICES, args, kwargs);
+}
+
+static PyObject* pack_normals_tangents_into(PyObject* self, PyObject* args, PyObject* kwargs) {
+    return pack_into(PACK_NORMALS_TANGENTS, args, kwargs);
+}
+
+static PyObject* pack_uvs_into(PyObject* self, PyObject* args, PyObject* kwargs) {
+    return pack_into(PACK_UVS, args, kwargs);
+}
+
+static PyObject* pack_colors_into(PyObject* self, PyObject* args, PyObject* kwargs) {
+    return pack_into(PACK_COPY, args, kwargs);
+}
+
+static PyObject* pack_weights_into(PyObject* self, PyObject* args, PyObject* kwargs) {
+    return pack_into(PACK_WEIGHTS, args, kwargs);
+}
+
+static PyObject* pack_indices_into(PyObject* self, PyObject* args, PyObject* kwargs) {
+    return pack_into(PACK_INDICES, args, kwargs);
+}
+
+/* Upper bound on the bytes encoded per write when streaming to a file. */
+#define WRITE_CHUNK ((Py_ssize_t)32 << 20)
+
+static int stream_kind(const char* name) {
+    if (strcmp(name, "normals_tangents") == 0) return PACK_NORMALS_TANGENTS;
+    if (strcmp(name, "uvs") == 0) return PACK_UVS;
+    if (strcmp(name, "weights") == 0) return PACK_WEIGHTS;
+    if (strcmp(name, "indices") == 0) return PACK_INDICES;
+    if (strcmp(name, "colors") == 0 || strcmp(name, "bytes") == 0) return PACK_COPY;
+    PyErr_Format(PyExc_ValueError, "unknown stream kind '%s' (expected normals_tangents, uvs, weights, indices, colors or bytes)", name);
+    return -1;
 }
 
-static PyObject* pack_colors(PyObject* self, PyObject* args) {
-    PyObject* arr_obj;
-    if (!PyArg_ParseTuple(args, "O", &arr_obj))
+static PyObject* write_streams(PyObject* self, PyObject* args, PyObject* kwargs) {
+    static char* kwlist[] = {"target", "streams", "truncate", NULL};
+    PyObject* target;
+    PyObject* streams_obj;
+    int truncate = 1;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "OO|p", kwlist, &target, &streams_obj, &truncate))
         return NULL;
+    PyObject* seq = PySequence_Fast(streams_obj, "streams must be a sequence of (offset, kind, args[, kwargs]) tuples");
+    if (!seq) return NULL;
+    Py_ssize_t n = PySequence_Fast_GET_SIZE(seq);
+
+    /* Everything is validated before the first byte is written. */
+    pack_stream* streams = (pack_stream*)PyMem_Calloc(n ? (size_t)n : 1, sizeof(pack_stream));
+    Py_ssize_t* offsets = (Py_ssize_t*)PyMem_Calloc(n ? (size_t)n : 1, sizeof(Py_ssize_t));
+    Py_ssize_t opened = 0, end = 0, largest = 0;
+    PyObject* result = NULL;
+    FILE* fp = NULL;
+    unsigned char* chunk = NULL;
     Py_buffer view;
-    if (PyObject_GetBuffer(arr_obj, &view, PyBUF_SIMPLE) < 0)
+    int have_view = 0;
+    if (!streams || !offsets) { PyErr_NoMemory(); goto done; }
+    for (; opened < n; ++opened) {
+        Py_ssize_t offset;
+        const char* kind_name;
+        PyObject* pack_args;
+        PyObject* pack_kwargs = NULL;
+        if (!PyArg_ParseTuple(PySequence_Fast_GET_ITEM(seq, opened), "nsO!|O!;streams are (offset, kind, args[, kwargs]) tuples",
+                              &offset, &kind_name, &PyTuple_Type, &pack_args, &PyDict_Type, &pack_kwargs))
+            goto done;
+        int kind = stream_kind(kind_name);
+        if (kind < 0 || pack_stream_open(&streams[opened], kind, pack_args, pack_kwargs) < 0)
+            goto done;
+        if (offset < 0) {
+            PyErr_Format(PyExc_ValueError, "stream %zd: offset must be >= 0", opened);
+            ++opened;
+            goto done;
+        }
+        offsets[opened] = offset;
+        Py_ssize_t stream_end = offset + pack_stream_size(&streams[opened]);
+        if (stream_end > end) end = stream_end;
+        if (pack_stream_size(&streams[opened]) > largest) largest = pack_stream_size(&streams[opened]);
+    }
+
+    if (PyObject_CheckBuffer(target)) {
+        if (get_pack_target(target, 0, end, &view) < 0) goto done;
+        have_view = 1;
+        for (Py_ssize_t k = 0; k < n; ++k)
+            if (pack_stream_encode(&streams[k], 0, streams[k].count, (unsigned char*)view.buf + offsets[k]) < 0)
+                goto done;
+    } else {
+        /* With truncate the file is rewritten from empty, so gaps between streams read as zeros
+         * and the file ends exactly at `end`. Without it an existing file is patched in place and
+         * its bytes outside the streams, gaps included, are left as they were. */
+        native_path_char* path = native_path_from_object(target);
+        if (!path) goto done;
+        fp = truncate ? NULL : native_fopen_path(path, "r+b");
+        if (!fp && (truncate || errno == ENOENT)) fp = native_fopen_path(path, "w+b");
+        PyMem_RawFree(path);
+        if (!fp) { PyErr_SetFromErrnoWithFilenameObject(PyExc_OSError, target); goto done; }
+        /* never below one record: every record is at most 2 * MAX_BONES bytes */
+        Py_ssize_t chunk_size = largest < WRITE_CHUNK ? largest : WRITE_CHUNK;
+        chunk = (unsigned char*)PyMem_Malloc(chunk_size ? (size_t)chunk_size : 1);
+        if (!chunk) { PyErr_NoMemory(); goto done; }
+        for (Py_ssize_t k = 0; k < n; ++k) {
+            const pack_stream* s = &streams[k];
+            Py_ssize_t per_chunk = chunk_size / s->record_size;
+            if (native_fseek(fp, (unsigned long long)offsets[k]) != 0) {
+                PyErr_SetFromErrnoWithFilenameObject(PyExc_OSError, target);
+                goto done;
+            }
+            for (Py_ssize_t begin = 0; begin < s->count; begin += per_chunk) {
+                Py_ssize_t stop = s->count - begin < per_chunk ? s->count : begin + per_chunk;
+                if (pack_stream_encode(s, begin, stop, chunk) < 0) goto done;
+                size_t bytes = (size_t)((stop - begin) * s->record_size);
+                unsigned long long started = native_stats_clock(&stats);
+                if (fwrite(chunk, 1, bytes, fp) != bytes) {
+                    PyErr_SetFromErrnoWithFilenameObject(PyExc_OSError, target);
+                    goto done;
+                }
+                stats_phase(STAT_WRITE_NS, started, STAT_WRITE_BYTES, (long long)bytes);
+            }
+        }
+        if (truncate ? native_ftruncate(fp, (unsigned long long)end) != 0 : fflush(fp) != 0) {
+            PyErr_SetFromErrnoWithFilenameObject(PyExc_OSError, target);
+            goto done;
+        }
+    }
+    result = PyLong_FromSsize_t(end);
+
+done:
+    if (fp && fclose(fp) != 0 && result) {
+        Py_CLEAR(result);
+        PyErr_SetFromErrnoWithFilenameObject(PyExc_OSError, target);
+    }
+    PyMem_Free(chunk);
+    if (have_view) PyBuffer_Release(&view);
+    while (opened > 0) pack_stream_close(&streams[--opened]);
+    PyMem_Free(streams);
+    PyMem_Free(offsets);
+    Py_DECREF(seq);
+    return result;
+}
+
+/* Generic strided decoding: each layout element names an attribute at `offset`
+ * repeating every `stride` bytes, e.g. (0, 8, "snorm8x3") for the normal xyz of
+ * an 8-byte normal/tangent record. The data is walked in vertex blocks so every
+ * stream is read front to back once, whatever the layout. */
+
+enum {
+    ATTR_FLOAT, ATTR_HALF, ATTR_SNORM8, ATTR_UNORM8, ATTR_SNORM16, ATTR_UNORM16,
+    ATTR_UINT8, ATTR_UINT16, ATTR_UINT32,
+};
+
+static const struct {
+    const char* name;
+    int type;
+    int size;
+    const char* typecode;
+} attr_types[] = {
+    {"float", ATTR_FLOAT, 4, "f"},
+    {"half", ATTR_HALF, 2, "f"},
+    {"snorm8", ATTR_SNORM8, 1, "f"},
+    {"unorm8", ATTR_UNORM8, 1, "f"},
+    {"snorm16", ATTR_SNORM16, 2, "f"},
+    {"unorm16", ATTR_UNORM16, 2, "f"},
+    {"uint8", ATTR_UINT8, 1, "B"},
+    {"uint16", ATTR_UINT16, 2, "H"},
+    {"uint32", ATTR_UINT32, 4, "I"},
+};
+
+#define DECODE_BLOCK 1024
+
+typedef struct {
+    const unsigned char* src;
+    Py_ssize_t stride;
+    int kind;
+    int type;
+    int size;
+    int components;
+    int flip;                /* half only: store 1 - value, as unpack_uvs does */
+    unsigned char* dst;
+    Py_ssize_t dst_stride;   /* bytes between consecutive vertices in dst */
+} vertex_element;
+
+/* Parses "float3", "half2", "snorm8x4", "uint16" (one component) and so on;
+ * names ending in a digit take their component count after an 'x'. */
+static int parse_attr_format(const char* format, int* index, int* components) {
+    for (int k = 0; k < (int)(sizeof(attr_types) / sizeof(attr_types[0])); ++k) {
+        size_t len = strlen(attr_types[k].name);
+        if (strncmp(format, attr_types[k].name, len) != 0)
+            continue;
+        const char* rest = format + len;
+        if (*rest == '\0') {
+            *index = k;
+            *components = 1;
+            return 0;
+        }
+        if (rest[0] == 'x')
+            ++rest;
+        else if (attr_types[k].name[len - 1] >= '0' && attr_types[k].name[len - 1] <= '9')
+            continue;
+        if (rest[0] >= '1' && rest[0] <= '4' && rest[1] == '\0') {
+            *index = k;
+            *components = rest[0] - '0';
+            return 0;
+        }
+    }
+    PyErr_Format(PyExc_ValueError, "unknown vertex format '%s'", format);
+    return -1;
+}
+
+/* Runs `expr` (reading component c at p) for every component in [begin, end) and
+ * stores the T result at the element's destination stride. */
+#define DECODE_LOOP(T, expr) \
+    for (Py_ssize_t i = begin; i < end; ++i) { \
+        const unsigned char* src = e->src + i * e->stride; \
+        unsigned char* dst = e->dst + i * e->dst_stride; \
+        for (int c = 0; c < e->components; ++c) { \
+            const unsigned char* p = src + c * e->size; \
+            T value = (expr); \
+            memcpy(dst + c * sizeof(T), &value, sizeof(T)); \
+        } \
+    }
+
+static void decode_element(const vertex_element* e, Py_ssize_t begin, Py_ssize_t end) {
+    switch (e->type) {
+    case ATTR_FLOAT:   DECODE_LOOP(uint32_t, load_u32(p)) break;
+    case ATTR_HALF:
+        if (e->flip) DECODE_LOOP(float, (float)(1.0 - half_table[load_u16(p)]))
+        else DECODE_LOOP(float, (float)half_table[load_u16(p)])
+        break;
+    case ATTR_SNORM8:  DECODE_LOOP(float, (signed char)p[0] / 127.0f) break;
+    case ATTR_UNORM8:  DECODE_LOOP(float, p[0] / 255.0f) break;
+    case ATTR_SNORM16: DECODE_LOOP(float, (int16_t)load_u16(p) / 32767.0f) break;
+    case ATTR_UNORM16: DECODE_LOOP(float, load_u16(p) / 65535.0f) break;
+    case ATTR_UINT8:   DECODE_LOOP(unsigned char, p[0]) break;
+    case ATTR_UINT16:  DECODE_LOOP(uint16_t, load_u16(p)) break;
+    case ATTR_UINT32:  DECODE_LOOP(uint32_t, load_u32(p)) break;
+    }
+}
+
+#undef DECODE_LOOP
+
+/* One decode_vertices call: the source and output buffers stay acquired until
+ * vertex_job_release so the decode itself can run without the GIL. */
+typedef struct {
+    Py_buffer view;
+    int have_view;
+    vertex_element* elements;
+    Py_ssize_t n;
+    Py_ssize_t count;
+    Py_buffer* out_views;
+    Py_ssize_t held;
+    PyObject* result;
+} vertex_job;
+
+static void vertex_job_release(vertex_job* job) {
+    while (job->held > 0) PyBuffer_Release(&job->out_views[--job->held]);
+    PyMem_Free(job->out_views);
+    PyMem_Free(job->elements);
+    job->out_views = NULL;
+    job->elements = NULL;
+    if (job->have_view) PyBuffer_Release(&job->view);
+    job->have_view = 0;
+}
+
+/* Parses one job and allocates its outputs into job->result; returns 0 or -1. */
+static int vertex_job_prepare(vertex_job* job, PyObject* data, PyObject* layout_obj, PyObject* count_obj, PyObject* out_obj) {
+    memset(job, 0, sizeof(*job));
+    if (PyObject_GetBuffer(data, &job->view, PyBUF_SIMPLE) < 0)
+        return -1;
+    job->have_view = 1;
+
+    PyObject* layout = PySequence_Fast(layout_obj, "layout must be a sequence of (offset, stride, format) tuples");
+    PyObject* outs = NULL;
+    if (!layout) return -1;
+    Py_ssize_t n = job->n = PySequence_Fast_GET_SIZE(layout);
+
+    if (out_obj != Py_None) {
+        outs = PySequence_Fast(out_obj, "out must be a sequence with one buffer (or None) per layout element");
+        if (!outs) goto done;
+        if (PySequence_Fast_GET_SIZE(outs) != n) {
+            PyErr_SetString(PyExc_ValueError, "out must have one entry per layout element");
+            goto done;
+        }
+    }
+
+    vertex_element* elements = job->elements = (vertex_element*)PyMem_Calloc(n ? (size_t)n : 1, sizeof(vertex_element));
+    job->out_views = (Py_buffer*)PyMem_Calloc(n ? (size_t)n : 1, sizeof(Py_buffer));
+    if (!elements || !job->out_views) {
+        PyErr_NoMemory();
+        goto done;
+    }
+
+    /* Without an explicit count, decode as many vertices as every element can supply. */
+    Py_ssize_t count = PY_SSIZE_T_MAX;
+    for (Py_ssize_t k = 0; k < n; ++k) {
+        Py_ssize_t offset, stride;
+        const char* format;
+        if (!PyArg_ParseTuple(PySequence_Fast_GET_ITEM(layout, k), "nns;layout entries are (offset, stride, format)", &offset, &stride, &format))
+            break;
+        if (parse_attr_format(format, &elements[k].kind, &elements[k].components) < 0)
+            break;
+        elements[k].type = attr_types[elements[k].kind].type;
+        elements[k].size = attr_types[elements[k].kind].size;
+        Py_ssize_t width = (Py_ssize_t)elements[k].size * elements[k].components;
+        if (offset < 0 || stride < width) {
+            PyErr_Format(PyExc_ValueError, "layout element %zd: offset must be >= 0 and stride >= %zd", k, width);
+            break;
+        }
+        elements[k].src = (const unsigned char*)job->view.buf + offset;
+        elements[k].stride = stride;
+        Py_ssize_t available = job->view.len - offset < width ? 0 : (job->view.len - offset - width) / stride + 1;
+        if (available < count) count = available;
+    }
+    if (PyErr_Occurred())
+        goto done;
+    if (n == 0) count = 0;
+    if (count_obj != Py_None) {
+        Py_ssize_t requested = PyNumber_AsSsize_t(count_obj, PyExc_OverflowError);
+        if (requested == -1 && PyErr_Occurred())
+            goto done;
+        if (requested < 0 || requested > count) {
+            PyErr_Format(PyExc_ValueError, "count %zd out of range: the data holds %zd vertices for this layout", requested, count);
+            goto done;
+        }
+        count = requested;
+    }
+    job->count = count;
+
+    job->result = PyTuple_New(n);
+    if (!job->result)
+        goto done;
+    for (Py_ssize_t k = 0; k < n; ++k) {
+        const char* typecode = attr_types[elements[k].kind].typecode;
+        Py_ssize_t items = count * elements[k].components;
+        PyObject* target = outs ? PySequence_Fast_GET_ITEM(outs, k) : Py_None;
+        Py_ssize_t itemsize = typecode[0] == 'B' ? 1 : typecode[0] == 'H' ? 2 : 4;
+        PyObject* arr;
+        void* dst;
+        elements[k].dst_stride = itemsize * elements[k].components;
+        if (target == Py_None) {
+            arr = new_array(typecode, items, &dst);
+            if (!arr) break;
+            elements[k].dst = (unsigned char*)dst;
+        } else {
+            if (get_out_buffer(target, items * itemsize, &job->out_views[job->held]) < 0)
+                break;
+            elements[k].dst = (unsigned char*)job->out_views[job->held++].buf;
+            Py_INCREF(target);
+            arr = target;
+        }
+        PyTuple_SET_ITEM(job->result, k, arr);
+    }
+    if (PyErr_Occurred())
+        Py_CLEAR(job->result);
+
+done:
+    Py_XDECREF(outs);
+    Py_DECREF(layout);
+    return job->result ? 0 : -1;
+}
+
+/* Decodes vertex blocks [first_block, last_block) of a prepared job on `worker`. */
+static void vertex_job_run(const vertex_job* job, Py_ssize_t first_block, Py_ssize_t last_block, int worker) {
+    unsigned long long started = native_stats_clock(&stats);
+    Py_ssize_t vertices = 0;
+    for (Py_ssize_t block = first_block; block < last_block; ++block) {
+        Py_ssize_t begin = block * DECODE_BLOCK;
+        Py_ssize_t end = job->count - begin < DECODE_BLOCK ? job->count : begin + DECODE_BLOCK;
+        for (Py_ssize_t k = 0; k < job->n; ++k)
+            decode_element(&job->elements[k], begin, end);
+        vertices += end - begin;
+    }
+    if (started) {
+        native_stats_time(&stats, worker, STAT_DECODE_NS, started);
+        native_stats_add(&stats, worker, STAT_DECODE_VERTICES, vertices);
+    }
+}
+
+static Py_ssize_t vertex_job_blocks(const vertex_job* job) {
+    return (job->count + DECODE_BLOCK - 1) / DECODE_BLOCK;
+}
+
+static PyObject* decode_vertices(PyObject* self, PyObject* args, PyObject* kwargs) {
+    static char* kwlist[] = {"data", "layout", "count", "out", NULL};
+    PyObject* data;
+    PyObject* layout_obj;
+    PyObject* count_obj = Py_None;
+    PyObject* out_obj = Py_None;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "OO|OO", kwlist, &data, &layout_obj, &count_obj, &out_obj))
         return NULL;
-    PyObject* bytes = PyBytes_FromStringAndSize((const char*)view.buf, view.len);
+    vertex_job job;
+    if (vertex_job_prepare(&job, data, layout_obj, count_obj, out_obj) == 0)
+        vertex_job_run(&job, 0, vertex_job_blocks(&job), 0);
+    vertex_job_release(&job);
+    return job.result;
+}
+
+/* decode_batch: jobs are flattened into one run of vertex blocks that
+ * native_parallel_for splits across workers; each block writes its own slice of
+ * one job's outputs, so the split never changes the results. */
+#define BATCH_MIN_BLOCKS 16
+
+typedef struct {
+    const vertex_job* jobs;
+    const Py_ssize_t* first_block;   /* prefix sums, jobs + 1 entries */
+    Py_ssize_t njobs;
+} batch_ctx;
+
+static void batch_range(void* arg, Py_ssize_t begin, Py_ssize_t end, int worker) {
+    const batch_ctx* ctx = (const batch_ctx*)arg;
+    /* first job whose blocks reach past begin */
+    Py_ssize_t lo = 0, hi = ctx->njobs;
+    while (lo < hi) {
+        Py_ssize_t mid = lo + (hi - lo) / 2;
+        if (ctx->first_block[mid + 1] <= begin) lo = mid + 1;
+        else hi = mid;
+    }
+    for (Py_ssize_t j = lo; j < ctx->njobs && ctx->first_block[j] < end; ++j) {
+        Py_ssize_t from = begin > ctx->first_block[j] ? begin : ctx->first_block[j];
+        Py_ssize_t to = end < ctx->first_block[j + 1] ? end : ctx->first_block[j + 1];
+        vertex_job_run(&ctx->jobs[j], from - ctx->first_block[j], to - ctx->first_block[j], worker);
+    }
+}
+
+static PyObject* decode_batch(PyObject* self, PyObject* args, PyObject* kwargs) {
+    static char* kwlist[] = {"jobs", "threads", NULL};
+    PyObject* jobs_obj;
+    int threads = 0;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O|i", kwlist, &jobs_obj, &threads))
+        return NULL;
+    if (threads < 0) {
+        PyErr_SetString(PyExc_ValueError, "threads must be >= 0 (0 uses every core)");
+        return NULL;
+    }
+    PyObject* seq = PySequence_Fast(jobs_obj, "jobs must be a sequence of (data, layout[, count[, out]]) tuples");
+    if (!seq) return NULL;
+    Py_ssize_t njobs = PySequence_Fast_GET_SIZE(seq);
+    vertex_job* jobs = (vertex_job*)PyMem_Calloc(njobs ? (size_t)njobs : 1, sizeof(vertex_job));
+    Py_ssize_t* first_block = (Py_ssize_t*)PyMem_Calloc((size_t)njobs + 1, sizeof(Py_ssize_t));
+    PyObject* results = NULL;
+    Py_ssize_t prepared = 0;
+    if (!jobs || !first_block) { PyErr_NoMemory(); goto done; }
+
+    for (; prepared < njobs; ++prepared) {
+        PyObject *data, *layout, *count = Py_None, *out = Py_None;
+        if (!PyArg_ParseTuple(PySequence_Fast_GET_ITEM(seq, prepared), "OO|OO;jobs are (data, layout[, count[, out]]) tuples", &data, &layout, &count, &out))
+            goto done;
+        if (vertex_job_prepare(&jobs[prepared], data, layout, count, out) < 0) {
+            vertex_job_release(&jobs[prepared]);
+            goto done;
+        }
+        first_block[prepared + 1] = first_block[prepared] + vertex_job_blocks(&jobs[prepared]);
+    }
+
+    batch_ctx ctx = {jobs, first_block, njobs};
+    int workers = native_thread_count(threads);
+    Py_BEGIN_ALLOW_THREADS
+    native_parallel_for(first_block[njobs], workers, BATCH_MIN_BLOCKS, batch_range, &ctx);
+    Py_END_ALLOW_THREADS
+
+    results = PyList_New(njobs);
+    if (!results) goto done;
+    for (Py_ssize_t j = 0; j < njobs; ++j) {
+        PyList_SET_ITEM(results, j, jobs[j].result);
+        jobs[j].result = NULL;
+    }
+
+done:
+    for (Py_ssize_t j = 0; jobs && j < prepared; ++j) {
+        vertex_job_release(&jobs[j]);
+        Py_XDECREF(jobs[j].result);
+    }
+    PyMem_Free(jobs);
+    PyMem_Free(first_block);
+    Py_DECREF(seq);
+    return results;
+}
+
+/* Viewer vertex buffer: position float3, normal float3, uv float2 (flipped like
+ * unpack_uvs), color RGBA8; 36 bytes per vertex. */
+#define VBO_STRIDE 36
+#define VBO_STREAMS 4
+
+static const struct {
+    const char* name;
+    Py_ssize_t offset;
+    const char* format;      /* source encoding in the MESH vertex buffer */
+    Py_ssize_t default_stride;
+    int components;
+    const char* gl_type;
+} vbo_layout[VBO_STREAMS] = {
+    {"position", 0, "float3", 12, 3, "float"},
+    {"normal", 12, "snorm8x3", 8, 3, "float"},
+    {"uv", 24, "half2", 4, 2, "float"},
+    {"color", 32, "uint8x4", 4, 4, "unorm8"},
+};
+
+/* Accepts a buffer or a (buffer, offset, stride) tuple for one source stream. */
+static int get_vbo_stream(PyObject* obj, Py_ssize_t default_stride, Py_buffer* view, Py_ssize_t* offset, Py_ssize_t* stride) {
+    PyObject* data = obj;
+    *offset = 0;
+    *stride = default_stride;
+    if (PyTuple_Check(obj) && !PyArg_ParseTuple(obj, "Onn;streams are buffers or (buffer, offset, stride) tuples", &data, offset, stride))
+        return -1;
+    return PyObject_GetBuffer(data, view, PyBUF_SIMPLE);
+}
+
+static PyObject* build_vertex_buffer(PyObject* self, PyObject* args, PyObject* kwargs) {
+    static char* kwlist[] = {"positions", "normals", "uvs", "colors", "out", NULL};
+    PyObject* sources[VBO_STREAMS] = {NULL, Py_None, Py_None, Py_None};
+    PyObject* out_obj = Py_None;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O|OOOO", kwlist, &sources[0], &sources[1], &sources[2], &sources[3], &out_obj))
+        return NULL;
+
+    Py_buffer views[VBO_STREAMS];
+    vertex_element elements[VBO_STREAMS];
+    int used[VBO_STREAMS] = {0};
+    PyObject* result = NULL;
+    Py_ssize_t count = PY_SSIZE_T_MAX;
+    for (int k = 0; k < VBO_STREAMS; ++k) {
+        if (k > 0 && sources[k] == Py_None)
+            continue;
+        Py_ssize_t offset, stride;
+        if (get_vbo_stream(sources[k], vbo_layout[k].default_stride, &views[k], &offset, &stride) < 0)
+            goto done;
+        used[k] = 1;
+        vertex_element* e = &elements[k];
+        parse_attr_format(vbo_layout[k].format, &e->kind, &e->components);
+        e->type = attr_types[e->kind].type;
+        e->size = attr_types[e->kind].size;
+        e->flip = k == 2;
+        Py_ssize_t width = (Py_ssize_t)e->size * e->components;
+        if (offset < 0 || stride < width) {
+            PyErr_Format(PyExc_ValueError, "%s stream: offset must be >= 0 and stride >= %zd", vbo_layout[k].name, width);
+            goto done;
+        }
+        e->src = (const unsigned char*)views[k].buf + offset;
+        e->stride = stride;
+        e->dst_stride = VBO_STRIDE;
+        Py_ssize_t available = views[k].len - offset < width ? 0 : (views[k].len - offset - width) / stride + 1;
+        if (k == 0) {
+            count = available;
+        } else if (available < count) {
+            PyErr_Format(PyExc_ValueError, "%s stream holds %zd vertices, positions need %zd", vbo_layout[k].name, available, count);
+            goto done;
+        }
+    }
+
+    unsigned char* vbo;
+    Py_buffer out_view;
+    if (out_obj == Py_None) {
+        result = PyByteArray_FromStringAndSize(NULL, count * VBO_STRIDE);
+        if (!result) goto done;
+        vbo = (unsigned char*)PyByteArray_AS_STRING(result);
+    } else {
+        if (get_out_buffer(out_obj, count * VBO_STRIDE, &out_view) < 0) goto done;
+        vbo = (unsigned char*)out_view.buf;
+    }
+    for (int k = 0; k < VBO_STREAMS; ++k)
+        elements[k].dst = vbo + vbo_layout[k].offset;
+
+    static const unsigned char white[4] = {255, 255, 255, 255};
+    for (Py_ssize_t begin = 0; begin < count; begin += DECODE_BLOCK) {
+        Py_ssize_t end = count - begin < DECODE_BLOCK ? count : begin + DECODE_BLOCK;
+        for (int k = 0; k < VBO_STREAMS; ++k) {
+            if (used[k]) {
+                decode_element(&elements[k], begin, end);
+                continue;
+            }
+            /* missing streams: zero normal and uv, opaque white color */
+            for (Py_ssize_t i = begin; i < end; ++i) {
+                unsigned char* dst = vbo + i * VBO_STRIDE + vbo_layout[k].offset;
+                if (k == 3) memcpy(dst, white, 4);
+                else memset(dst, 0, (size_t)vbo_layout[k].components * sizeof(float));
+            }
+        }
+    }
+    if (out_obj != Py_None) {
+        PyBuffer_Release(&out_view);
+        Py_INCREF(out_obj);
+        result = out_obj;
+    }
+
+done:
+    for (int k = 0; k < VBO_STREAMS; ++k)
+        if (used[k]) PyBuffer_Release(&views[k]);
+    return result;
+}
+
+/* Mesh analysis for edited meshes: bounds and smooth normals/tangents over float3
+ * positions and raw 16/32-bit triangle-list indices. Large inputs are split
+ * across native_parallel_for workers with the GIL released; every result is
+ * independent of the worker count. */
+
+#define GEOMETRY_MIN_CHUNK 65536
+
+static int check_threads(int threads) {
+    if (threads < 0) {
+        PyErr_SetString(PyExc_ValueError, "threads must be >= 0 (0 uses every core)");
+        return -1;
+    }
+    return 0;
+}
+
+typedef struct {
+    const float* positions;
+    float mins[NATIVE_MAX_THREADS][3];
+    float maxs[NATIVE_MAX_THREADS][3];
+    double center[3];
+    double radius2[NATIVE_MAX_THREADS];
+} bounds_ctx;
+
+/* NaN coordinates never win a comparison, so they are ignored. */
+static void bounds_scalar(const float* p, Py_ssize_t begin, Py_ssize_t end, float* mn, float* mx) {
+    for (Py_ssize_t i = begin; i < end; ++i) {
+        for (int c = 0; c < 3; ++c) {
+            float v = p[i * 3 + c];
+            if (v < mn[c]) mn[c] = v;
+            if (v > mx[c]) mx[c] = v;
+        }
+    }
+}
+
+#ifdef NATIVE_X86
+/* Four vertices are three vectors whose lanes cycle x y z x / y z x y / z x y z;
+ * min(v, acc) keeps acc when v is NaN, matching the scalar loop. */
+NATIVE_TARGET("sse2")
+static Py_ssize_t bounds_sse2(const float* p, Py_ssize_t begin, Py_ssize_t end, float* mn, float* mx) {
+    __m128 lo[3], hi[3];
+    for (int k = 0; k < 3; ++k) {
+        lo[k] = _mm_set1_ps(INFINITY);
+        hi[k] = _mm_set1_ps(-INFINITY);
+    }
+    Py_ssize_t i = begin;
+    for (; i + 4 <= end; i += 4) {
+        for (int k = 0; k < 3; ++k) {
+            __m128 v = _mm_loadu_ps(p + i * 3 + k * 4);
+            lo[k] = _mm_min_ps(v, lo[k]);
+            hi[k] = _mm_max_ps(v, hi[k]);
+        }
+    }
+    float l[12], h[12];
+    for (int k = 0; k < 3; ++k) {
+        _mm_storeu_ps(l + k * 4, lo[k]);
+        _mm_storeu_ps(h + k * 4, hi[k]);
+    }
+    for (int lane = 0; lane < 12; ++lane) {
+        int c = lane % 3;
+        if (l[lane] < mn[c]) mn[c] = l[lane];
+        if (h[lane] > mx[c]) mx[c] = h[lane];
+    }
+    return i;
+}
+#endif
+
+static void bounds_range(void* arg, Py_ssize_t begin, Py_ssize_t end, int worker) {
+    bounds_ctx* ctx = (bounds_ctx*)arg;
+    float* mn = ctx->mins[worker];
+    float* mx = ctx->maxs[worker];
+    for (int c = 0; c < 3; ++c) {
+        mn[c] = INFINITY;
+        mx[c] = -INFINITY;
+    }
+#ifdef NATIVE_X86
+    if (native_cpu_features() & NATIVE_CPU_SSE2)
+        begin = bounds_sse2(ctx->positions, begin, end, mn, mx);
+#endif
+    bounds_scalar(ctx->positions, begin, end, mn, mx);
+}
+
+static void radius_range(void* arg, Py_ssize_t begin, Py_ssize_t end, int worker) {
+    bounds_ctx* ctx = (bounds_ctx*)arg;
+    double best = 0.0;
+    for (Py_ssize_t i = begin; i < end; ++i) {
+        double dx = ctx->positions[i * 3 + 0] - ctx->center[0];
+        double dy = ctx->positions[i * 3 + 1] - ctx->center[1];
+        double dz = ctx->positions[i * 3 + 2] - ctx->center[2];
+        double d2 = dx * dx + dy * dy + dz * dz;
+        if (d2 > best) best = d2;
+    }
+    ctx->radius2[worker] = best;
+}
+
+/* Runs the AABB pass and merges the worker slots into mn/mx; returns 0 for no vertices. */
+static int compute_aabb(bounds_ctx* ctx, Py_ssize_t count, int threads, float* mn, float* mx) {
+    int workers = native_worker_count(count, native_thread_count(threads), GEOMETRY_MIN_CHUNK);
+    if (count == 0) return 0;
+    Py_BEGIN_ALLOW_THREADS
+    native_parallel_for(count, workers, GEOMETRY_MIN_CHUNK, bounds_range, ctx);
+    Py_END_ALLOW_THREADS
+    for (int c = 0; c < 3; ++c) {
+        mn[c] = ctx->mins[0][c];
+        mx[c] = ctx->maxs[0][c];
+        for (int w = 1; w < workers; ++w) {
+            if (ctx->mins[w][c] < mn[c]) mn[c] = ctx->mins[w][c];
+            if (ctx->maxs[w][c] > mx[c]) mx[c] = ctx->maxs[w][c];
+        }
+    }
+    return 1;
+}
+
+static PyObject* compute_bounds(PyObject* self, PyObject* args, PyObject* kwargs) {
+    static char* kwlist[] = {"positions", "threads", NULL};
+    Py_buffer view;
+    int threads = 0;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "y*|i", kwlist, &view, &threads))
+        return NULL;
+    if (check_threads(threads) < 0) { PyBuffer_Release(&view); return NULL; }
+    bounds_ctx* ctx = (bounds_ctx*)PyMem_Malloc(sizeof(bounds_ctx));
+    if (!ctx) { PyBuffer_Release(&view); return PyErr_NoMemory(); }
+    ctx->positions = (const float*)view.buf;
+    float mn[3], mx[3];
+    unsigned long long started = native_stats_clock(&stats);
+    int any = compute_aabb(ctx, view.len / 12, threads, mn, mx);
+    stats_phase(STAT_GEOMETRY_NS, started, STAT_GEOMETRY_VERTICES, view.len / 12);
+    PyMem_Free(ctx);
     PyBuffer_Release(&view);
-    return bytes;
+    if (!any) Py_RETURN_NONE;
+    return Py_BuildValue("((ddd)(ddd))", mn[0], mn[1], mn[2], mx[0], mx[1], mx[2]);
+}
+
+/* Sphere around the AABB center enclosing every vertex: not minimal, but a
+ * deterministic parallel pass, unlike Ritter-style growing. */
+static PyObject* compute_bounding_sphere(PyObject* self, PyObject* args, PyObject* kwargs) {
+    static char* kwlist[] = {"positions", "threads", NULL};
+    Py_buffer view;
+    int threads = 0;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "y*|i", kwlist, &view, &threads))
+        return NULL;
+    if (check_threads(threads) < 0) { PyBuffer_Release(&view); return NULL; }
+    bounds_ctx* ctx = (bounds_ctx*)PyMem_Malloc(sizeof(bounds_ctx));
+    if (!ctx) { PyBuffer_Release(&view); return PyErr_NoMemory(); }
+    ctx->positions = (const float*)view.buf;
+    Py_ssize_t count = view.len / 12;
+    float mn[3], mx[3];
+    PyObject* result;
+    unsigned long long started = native_stats_clock(&stats);
+    if (!compute_aabb(ctx, count, threads, mn, mx)) {
+        result = Py_NewRef(Py_None);
+    } else {
+        for (int c = 0; c < 3; ++c)
+            ctx->center[c] = ((double)mn[c] + (double)mx[c]) * 0.5;
+        int workers = native_worker_count(count, native_thread_count(threads), GEOMETRY_MIN_CHUNK);
+        Py_BEGIN_ALLOW_THREADS
+        native_parallel_for(count, workers, GEOMETRY_MIN_CHUNK, radius_range, ctx);
+        Py_END_ALLOW_THREADS
+        double radius2 = 0.0;
+        for (int w = 0; w < workers; ++w)
+            if (ctx->radius2[w] > radius2) radius2 = ctx->radius2[w];
+        result = Py_BuildValue("((ddd)d)", ctx->center[0], ctx->center[1], ctx->center[2], sqrt(radius2));
+    }
+    stats_phase(STAT_GEOMETRY_NS, started, STAT_GEOMETRY_VERTICES, count);
+    PyMem_Free(ctx);
+    PyBuffer_Release(&view);
+    return result;
+}
+
+/* Vertex -> triangle adjacency in CSR form. Each vertex lists its triangles in
+ * ascending order, so per-vertex sums run in a fixed order whatever the split. */
+typedef struct {
+    Py_ssize_t* offsets;     /* vertices + 1 */
+    uint32_t* triangles;     /* 3 per triangle */
+} vertex_adjacency;
+
+static uint32_t triangle_index(const unsigned char* indices, int index_size, Py_ssize_t k) {
+    return index_size == 2 ? load_u16(indices + k * 2) : load_u32(indices + k * 4);
+}
+
+/* Validates the indices and builds the adjacency; returns -1 with an error set. */
+static int build_adjacency(vertex_adjacency* adj, const unsigned char* indices, int index_size, Py_ssize_t triangles, Py_ssize_t vertices) {
+    adj->offsets = NULL;
+    adj->triangles = NULL;
+    if ((unsigned long long)triangles > 0xffffffffULL) {
+        PyErr_SetString(PyExc_OverflowError, "too many triangles");
+        return -1;
+    }
+    for (Py_ssize_t k = 0; k < triangles * 3; ++k) {
+        if (triangle_index(indices, index_size, k) >= (unsigned long long)vertices) {
+            PyErr_Format(PyExc_ValueError, "index %zd refers to vertex %lu of %zd", k, (unsigned long)triangle_index(indices, index_size, k), vertices);
+            return -1;
+        }
+    }
+    adj->offsets = (Py_ssize_t*)PyMem_RawCalloc((size_t)vertices + 1, sizeof(Py_ssize_t));
+    adj->triangles = (uint32_t*)PyMem_RawMalloc((size_t)(triangles ? triangles : 1) * 3 * sizeof(uint32_t));
+    Py_ssize_t* cursor = (Py_ssize_t*)PyMem_RawMalloc(((size_t)vertices + 1) * sizeof(Py_ssize_t));
+    if (!adj->offsets || !adj->triangles || !cursor) {
+        PyMem_RawFree(adj->offsets);
+        PyMem_RawFree(adj->triangles);
+        PyMem_RawFree(cursor);
+        adj->offsets = NULL;
+        adj->triangles = NULL;
+        PyErr_NoMemory();
+        return -1;
+    }
+    Py_BEGIN_ALLOW_THREADS
+    for (Py_ssize_t k = 0; k < triangles * 3; ++k)
+        ++adj->offsets[triangle_index(indices, index_size, k) + 1];
+    for (Py_ssize_t v = 0; v < vertices; ++v)
+        adj->offsets[v + 1] += adj->offsets[v];
+    memcpy(cursor, adj->offsets, ((size_t)vertices + 1) * sizeof(Py_ssize_t));
+    for (Py_ssize_t k = 0; k < triangles * 3; ++k)
+        adj->triangles[cursor[triangle_index(indices, index_size, k)]++] = (uint32_t)(k / 3);
+    Py_END_ALLOW_THREADS
+    PyMem_RawFree(cursor);
+    return 0;
+}
+
+static void free_adjacency(vertex_adjacency* adj) {
+    PyMem_RawFree(adj->offsets);
+    PyMem_RawFree(adj->triangles);
+}
+
+typedef struct {
+    const float* positions;
+    const unsigned char* indices;
+    int index_size;
+    const float* uvs32;      /* tangents: uv pairs as float32 ... */
+    const double* uvs64;     /* ... or float64 */
+    const float* normals;    /* tangents: per-vertex normals */
+    const vertex_adjacency* adj;
+    float* faces;            /* normals: 3 per triangle; tangents: sdir + tdir, 6 per triangle */
+    float* out;
+} surface_ctx;
+
+/* Unnormalized face normals: their length is twice the area, so summing them
+ * weights each face by area. */
+static void face_normals_range(void* arg, Py_ssize_t begin, Py_ssize_t end, int worker) {
+    surface_ctx* ctx = (surface_ctx*)arg;
+    (void)worker;
+    for (Py_ssize_t t = begin; t < end; ++t) {
+        const float* a = ctx->positions + 3 * (Py_ssize_t)triangle_index(ctx->indices, ctx->index_size, t * 3 + 0);
+        const float* b = ctx->positions + 3 * (Py_ssize_t)triangle_index(ctx->indices, ctx->index_size, t * 3 + 1);
+        const float* c = ctx->positions + 3 * (Py_ssize_t)triangle_index(ctx->indices, ctx->index_size, t * 3 + 2);
+        float e1[3] = {b[0] - a[0], b[1] - a[1], b[2] - a[2]};
+        float e2[3] = {c[0] - a[0], c[1] - a[1], c[2] - a[2]};
+        float* n = ctx->faces + t * 3;
+        n[0] = e1[1] * e2[2] - e1[2] * e2[1];
+        n[1] = e1[2] * e2[0] - e1[0] * e2[2];
+        n[2] = e1[0] * e2[1] - e1[1] * e2[0];
+    }
+}
+
+static void vertex_normals_range(void* arg, Py_ssize_t begin, Py_ssize_t end, int worker) {
+    surface_ctx* ctx = (surface_ctx*)arg;
+    (void)worker;
+    for (Py_ssize_t v = begin; v < end; ++v) {
+        float sum[3] = {0.0f, 0.0f, 0.0f};
+        for (Py_ssize_t k = ctx->adj->offsets[v]; k < ctx->adj->offsets[v + 1]; ++k) {
+            const float* n = ctx->faces + (Py_ssize_t)ctx->adj->triangles[k] * 3;
+            sum[0] += n[0];
+            sum[1] += n[1];
+            sum[2] += n[2];
+        }
+        float len = sqrtf(sum[0] * sum[0] + sum[1] * sum[1] + sum[2] * sum[2]);
+        float inv = len > 0.0f ? 1.0f / len : 0.0f;
+        ctx->out[v * 3 + 0] = sum[0] * inv;
+        ctx->out[v * 3 + 1] = sum[1] * inv;
+        ctx->out[v * 3 + 2] = sum[2] * inv;
+    }
+}
+
+/* Per-triangle UV-space tangent (sdir) and bitangent (tdir) directions. */
+static void face_tangents_range(void* arg, Py_ssize_t begin, Py_ssize_t end, int worker) {
+    surface_ctx* ctx = (surface_ctx*)arg;
+    (void)worker;
+    for (Py_ssize_t t = begin; t < end; ++t) {
+        uint32_t i0 = triangle_index(ctx->indices, ctx->index_size, t * 3 + 0);
+        uint32_t i1 = triangle_index(ctx->indices, ctx->index_size, t * 3 + 1);
+        uint32_t i2 = triangle_index(ctx->indices, ctx->index_size, t * 3 + 2);
+        const float* a = ctx->positions + 3 * (Py_ssize_t)i0;
+        const float* b = ctx->positions + 3 * (Py_ssize_t)i1;
+        const float* c = ctx->positions + 3 * (Py_ssize_t)i2;
+        float uv[3][2];
+        const uint32_t ids[3] = {i0, i1, i2};
+        for (int k = 0; k < 3; ++k) {
+            uv[k][0] = ctx->uvs32 ? ctx->uvs32[(Py_ssize_t)ids[k] * 2 + 0] : (float)ctx->uvs64[(Py_ssize_t)ids[k] * 2 + 0];
+            uv[k][1] = ctx->uvs32 ? ctx->uvs32[(Py_ssize_t)ids[k] * 2 + 1] : (float)ctx->uvs64[(Py_ssize_t)ids[k] * 2 + 1];
+        }
+        float x1[3] = {b[0] - a[0], b[1] - a[1], b[2] - a[2]};
+        float x2[3] = {c[0] - a[0], c[1] - a[1], c[2] - a[2]};
+        float s1 = uv[1][0] - uv[0][0], t1 = uv[1][1] - uv[0][1];
+        float s2 = uv[2][0] - uv[0][0], t2 = uv[2][1] - uv[0][1];
+        float det = s1 * t2 - s2 * t1;
+        float r = det != 0.0f ? 1.0f / det : 0.0f;
+        float* f = ctx->faces + t * 6;
+        for (int k = 0; k < 3; ++k) {
+            f[k] = (t2 * x1[k] - t1 * x2[k]) * r;
+            f[3 + k] = (s1 * x2[k] - s2 * x1[k]) * r;
+        }
+    }
+}
+
+/* Sums the face directions, orthogonalizes against the normal (Gram-Schmidt) and
+ * stores xyz plus the bitangent sign in w. */
+static void vertex_tangents_range(void* arg, Py_ssize_t begin, Py_ssize_t end, int worker) {
+    surface_ctx* ctx = (surface_ctx*)arg;
+    (void)worker;
+    for (Py_ssize_t v = begin; v < end; ++v) {
+        float sdir[3] = {0.0f, 0.0f, 0.0f}, tdir[3] = {0.0f, 0.0f, 0.0f};
+        for (Py_ssize_t k = ctx->adj->offsets[v]; k < ctx->adj->offsets[v + 1]; ++k) {
+            const float* f = ctx->faces + (Py_ssize_t)ctx->adj->triangles[k] * 6;
+            for (int c = 0; c < 3; ++c) {
+                sdir[c] += f[c];
+                tdir[c] += f[3 + c];
+            }
+        }
+        const float* n = ctx->normals + v * 3;
+        float d = n[0] * sdir[0] + n[1] * sdir[1] + n[2] * sdir[2];
+        float t[3] = {sdir[0] - n[0] * d, sdir[1] - n[1] * d, sdir[2] - n[2] * d};
+        float len = sqrtf(t[0] * t[0] + t[1] * t[1] + t[2] * t[2]);
+        float inv = len > 0.0f ? 1.0f / len : 0.0f;
+        float cross[3] = {n[1] * t[2] - n[2] * t[1], n[2] * t[0] - n[0] * t[2], n[0] * t[1] - n[1] * t[0]};
+        float* out = ctx->out + v * 4;
+        out[0] = t[0] * inv;
+        out[1] = t[1] * inv;
+        out[2] = t[2] * inv;
+        out[3] = cross[0] * tdir[0] + cross[1] * tdir[1] + cross[2] * tdir[2] < 0.0f ? -1.0f : 1.0f;
+    }
+}
+
+/* Computes smooth normals into ctx->out for a validated mesh; expects ctx->adj. */
+static int run_normals(surface_ctx* ctx, Py_ssize_t triangles, Py_ssize_t vertices, int threads) {
+    ctx->faces = (float*)PyMem_RawMalloc((size_t)(triangles ? triangles : 1) * 3 * sizeof(float));
+    if (!ctx->faces) { PyErr_NoMemory(); return -1; }
+    int workers = native_thread_count(threads);
+    Py_BEGIN_ALLOW_THREADS
+    native_parallel_for(triangles, workers, GEOMETRY_MIN_CHUNK, face_normals_range, ctx);
+    native_parallel_for(vertices, workers, GEOMETRY_MIN_CHUNK, vertex_normals_range, ctx);
+    Py_END_ALLOW_THREADS
+    PyMem_RawFree(ctx->faces);
+    ctx->faces = NULL;
+    return 0;
+}
+
+static int get_mesh_buffers(PyObject* positions_obj, PyObject* indices_obj, int index_size, Py_buffer* positions, Py_buffer* indices) {
+    if (check_index_size(index_size) < 0) return -1;
+    if (PyObject_GetBuffer(positions_obj, positions, PyBUF_SIMPLE) < 0) return -1;
+    if (PyObject_GetBuffer(indices_obj, indices, PyBUF_SIMPLE) < 0) {
+        PyBuffer_Release(positions);
+        return -1;
+    }
+    return 0;
+}
+
+static PyObject* compute_normals(PyObject* self, PyObject* args, PyObject* kwargs) {
+    static char* kwlist[] = {"positions", "indices", "index_size", "threads", "out", NULL};
+    PyObject *positions_obj, *indices_obj, *out_obj = Py_None;
+    int index_size = 2, threads = 0;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "OO|iiO", kwlist, &positions_obj, &indices_obj, &index_size, &threads, &out_obj))
+        return NULL;
+    Py_buffer positions, indices;
+    if (check_threads(threads) < 0 || get_mesh_buffers(positions_obj, indices_obj, index_size, &positions, &indices) < 0)
+        return NULL;
+    Py_ssize_t vertices = positions.len / 12;
+    Py_ssize_t triangles = indices.len / (3 * index_size);
+
+    Py_buffer out_view;
+    void* dst;
+    PyObject* result = NULL;
+    vertex_adjacency adj;
+    surface_ctx ctx = {(const float*)positions.buf, (const unsigned char*)indices.buf, index_size, NULL, NULL, NULL, &adj, NULL, NULL};
+    unsigned long long started = native_stats_clock(&stats);
+    if (build_adjacency(&adj, ctx.indices, index_size, triangles, vertices) == 0) {
+        if (out_obj == Py_None) {
+            result = new_array("f", vertices * 3, &dst);
+        } else if (get_out_buffer(out_obj, vertices * 3 * (Py_ssize_t)sizeof(float), &out_view) == 0) {
+            dst = out_view.buf;
+            result = Py_NewRef(out_obj);
+        }
+        if (result) {
+            ctx.out = (float*)dst;
+            if (run_normals(&ctx, triangles, vertices, threads) < 0)
+                Py_CLEAR(result);
+            if (out_obj != Py_None) PyBuffer_Release(&out_view);
+        }
+        free_adjacency(&adj);
+    }
+    stats_phase(STAT_GEOMETRY_NS, started, STAT_GEOMETRY_VERTICES, vertices);
+    PyBuffer_Release(&positions);
+    PyBuffer_Release(&indices);
+    return result;
+}
+
+static PyObject* compute_tangents(PyObject* self, PyObject* args, PyObject* kwargs) {
+    static char* kwlist[] = {"positions", "uvs", "indices", "normals", "index_size", "threads", "out", NULL};
+    PyObject *positions_obj, *uvs_obj, *indices_obj, *normals_obj = Py_None, *out_obj = Py_None;
+    int index_size = 2, threads = 0;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "OOO|OiiO", kwlist, &positions_obj, &uvs_obj, &indices_obj, &normals_obj, &index_size, &threads, &out_obj))
+        return NULL;
+    Py_buffer positions, indices, uvs, normals;
+    int have_normals = 0;
+    if (check_threads(threads) < 0 || get_mesh_buffers(positions_obj, indices_obj, index_size, &positions, &indices) < 0)
+        return NULL;
+    Py_ssize_t vertices = positions.len / 12;
+    Py_ssize_t triangles = indices.len / (3 * index_size);
+    PyObject* result = NULL;
+    unsigned long long started = 0;
+    float* computed_normals = NULL;
+    vertex_adjacency adj = {NULL, NULL};
+    surface_ctx ctx = {(const float*)positions.buf, (const unsigned char*)indices.buf, index_size, NULL, NULL, NULL, &adj, NULL, NULL};
+    Py_buffer out_view;
+    void* dst;
+
+    /* UVs come as float32 pairs or as the float64 pairs unpack_uvs returns */
+    if (PyObject_GetBuffer(uvs_obj, &uvs, PyBUF_C_CONTIGUOUS | PyBUF_FORMAT) < 0) goto release_mesh;
+    int uv_double = uvs.format && strchr(uvs.format, 'd') != NULL;
+    if (uvs.len < vertices * 2 * (uv_double ? 8 : 4)) {
+        PyErr_Format(PyExc_ValueError, "uvs must hold a pair for each of the %zd vertices", vertices);
+        goto release_uvs;
+    }
+    if (uv_double) ctx.uvs64 = (const double*)uvs.buf;
+    else ctx.uvs32 = (const float*)uvs.buf;
+    if (normals_obj != Py_None) {
+        if (PyObject_GetBuffer(normals_obj, &normals, PyBUF_SIMPLE) < 0) goto release_uvs;
+        have_normals = 1;
+        if (normals.len < vertices * 12) {
+            PyErr_Format(PyExc_ValueError, "normals must hold xyz for each of the %zd vertices", vertices);
+            goto release_uvs;
+        }
+        ctx.normals = (const float*)normals.buf;
+    }
+
+    started = native_stats_clock(&stats);
+    if (build_adjacency(&adj, ctx.indices, index_size, triangles, vertices) < 0) goto release_uvs;
+    if (!have_normals) {
+        computed_normals = (float*)PyMem_RawMalloc((size_t)(vertices ? vertices : 1) * 3 * sizeof(float));
+        if (!computed_normals) { PyErr_NoMemory(); goto release_all; }
+        ctx.out = computed_normals;
+        if (run_normals(&ctx, triangles, vertices, threads) < 0) goto release_all;
+        ctx.normals = computed_normals;
+    }
+    ctx.faces = (float*)PyMem_RawMalloc((size_t)(triangles ? triangles : 1) * 6 * sizeof(float));
+    if (!ctx.faces) { PyErr_NoMemory(); goto release_all; }
+
+    if (out_obj == Py_None) {
+        result = new_array("f", vertices * 4, &dst);
+    } else if (get_out_buffer(out_obj, vertices * 4 * (Py_ssize_t)sizeof(float), &out_view) == 0) {
+        dst = out_view.buf;
+        result = Py_NewRef(out_obj);
+    }
+    if (result) {
+        ctx.out = (float*)dst;
+        int workers = native_thread_count(threads);
+        Py_BEGIN_ALLOW_THREADS
+        native_parallel_for(triangles, workers, GEOMETRY_MIN_CHUNK, face_tangents_range, &ctx);
+        native_parallel_for(vertices, workers, GEOMETRY_MIN_CHUNK, vertex_tangents_range, &ctx);
+        Py_END_ALLOW_THREADS
+        if (out_obj != Py_None) PyBuffer_Release(&out_view);
+    }
+
+release_all:
+    stats_phase(STAT_GEOMETRY_NS, started, STAT_GEOMETRY_VERTICES, vertices);
+    PyMem_RawFree(ctx.faces);
+    PyMem_RawFree(computed_normals);
+    free_adjacency(&adj);
+release_uvs:
+    if (have_normals) PyBuffer_Release(&normals);
+    PyBuffer_Release(&uvs);
+release_mesh:
+    PyBuffer_Release(&positions);
+    PyBuffer_Release(&indices);
+    return result;
+}
+
+static PyObject* stats_get(PyObject* self, PyObject* args, PyObject* kwargs) {
+    return native_stats_get_method(&stats, args, kwargs);
+}
+
+static PyObject* stats_enable(PyObject* self, PyObject* args, PyObject* kwargs) {
+    return native_stats_enable_method(&stats, args, kwargs);
+}
+
+static PyObject* stats_reset(PyObject* self, PyObject* unused) {
+    native_stats_reset(&stats);
+    Py_RETURN_NONE;
 }
 
 static PyMethodDef methods[] = {
-    {"unpack_normals_tangents", unpack_normals_tangents, METH_VARARGS, "Decode normals/tangents from bytes"},
-    {"pack_normals_tangents", pack_normals_tangents, METH_VARARGS, "Encode normals/tangents to bytes"},
-    {"unpack_uvs", unpack_uvs, METH_VARARGS, "Decode UV half floats"},
-    {"pack_uvs", pack_uvs, METH_VARARGS, "Encode UV floats"},
-    {"unpack_colors", unpack_colors, METH_VARARGS, "Decode RGBA colors"},
-    {"pack_colors", pack_colors, METH_VARARGS, "Encode RGBA colors"},
+    {"unpack_normals_tangents", (PyCFunction)(void(*)(void))unpack_normals_tangents, METH_VARARGS | METH_KEYWORDS,
+     "unpack_normals_tangents(data, out=None, xyzw=False) -> (normals, normal_ws, tangents, tangent_ws), "
+     "or (normals, tangents) as float4 vectors with xyzw; out is an optional tuple of writable buffers"},
+    {"pack_normals_tangents", (PyCFunction)(void(*)(void))pack_normals_tangents, METH_VARARGS | METH_KEYWORDS,
+     "pack_normals_tangents(normals, normal_ws, tangents, tangent_ws, renormalize=False, xyzw=False) -> bytes; "
+     "components saturate to the snorm8 range, xyzw packs float4 vectors with None for the w arrays"},
+    {"unpack_uvs", (PyCFunction)(void(*)(void))unpack_uvs, METH_VARARGS | METH_KEYWORDS,
+     "unpack_uvs(data, out=None, float32=False) -> array('d') (or 'f') of flipped UVs, or out filled with them"},
+    {"pack_uvs", (PyCFunction)(void(*)(void))pack_uvs, METH_VARARGS | METH_KEYWORDS,
+     "pack_uvs(uvs, float32=False) -> bytes of flipped half-float UVs from float64 (or float32) pairs"},
+    {"unpack_colors", (PyCFunction)(void(*)(void))unpack_colors, METH_VARARGS | METH_KEYWORDS,
+     "unpack_colors(data, out=None) -> array('B') of RGBA bytes, or out filled with them"},
+    {"pack_colors", (PyCFunction)(void(*)(void))pack_colors, METH_VARARGS | METH_KEYWORDS, "Encode RGBA colors"},
+    {"unpack_weights", (PyCFunction)(void(*)(void))unpack_weights, METH_VARARGS | METH_KEYWORDS,
+     "unpack_weights(data, bones=8, out=None) -> (bone indices array('B'), weights array('f'))"},
+    {"pack_weights", (PyCFunction)(void(*)(void))pack_weights, METH_VARARGS | METH_KEYWORDS,
+     "pack_weights(indices, weights, bones=8, normalize=False) -> bytes; normalize makes each vertex's weights sum to 255"},
+    {"unpack_indices", (PyCFunction)(void(*)(void))unpack_indices, METH_VARARGS | METH_KEYWORDS,
+     "unpack_indices(data, index_size=2, base=0, out=None) -> array('H') or array('I') with base added to every index"},
+    {"pack_indices", (PyCFunction)(void(*)(void))pack_indices, METH_VARARGS | METH_KEYWORDS,
+     "pack_indices(indices, index_size=2) -> bytes of 16- or 32-bit indices from any integer buffer"},
+    {"strip_to_triangles", (PyCFunction)(void(*)(void))strip_to_triangles, METH_VARARGS | METH_KEYWORDS,
+     "strip_to_triangles(data, index_size=2, restart=None, out=None) -> triangle-list indices; degenerates are dropped"},
+    {"pack_normals_tangents_into", (PyCFunction)(void(*)(void))pack_normals_tangents_into, METH_VARARGS | METH_KEYWORDS,
+     "pack_normals_tangents_into(buffer, offset, normals, normal_ws, tangents, tangent_ws, renormalize=False, xyzw=False) -> bytes written"},
+    {"pack_uvs_into", (PyCFunction)(void(*)(void))pack_uvs_into, METH_VARARGS | METH_KEYWORDS,
+     "pack_uvs_into(buffer, offset, uvs, float32=False) -> bytes written"},
+    {"pack_colors_into", (PyCFunction)(void(*)(void))pack_colors_into, METH_VARARGS | METH_KEYWORDS,
+     "pack_colors_into(buffer, offset, colors) -> bytes written"},
+    {"pack_weights_into", (PyCFunction)(void(*)(void))pack_weights_into, METH_VARARGS | METH_KEYWORDS,
+     "pack_weights_into(buffer, offset, indices, weights, bones=8, normalize=False) -> bytes written"},
+    {"pack_indices_into", (PyCFunction)(void(*)(void))pack_indices_into, METH_VARARGS | METH_KEYWORDS,
+     "pack_indices_into(buffer, offset, indices, index_size=2) -> bytes written"},
+    {"write_streams", (PyCFunction)(void(*)(void))write_streams, METH_VARARGS | METH_KEYWORDS,
+     "write_streams(target, streams, truncate=True) -> end offset; packs (offset, kind, args[, kwargs]) streams into a writable buffer "
+     "or a file path (kind: normals_tangents, uvs, weights, indices, colors or bytes); truncate=False patches an existing file in place, keeping its bytes in the gaps between streams"},
+    {"decode_vertices", (PyCFunction)(void(*)(void))decode_vertices, METH_VARARGS | METH_KEYWORDS,
+     "decode_vertices(data, layout, count=None, out=None) -> tuple with one array per (offset, stride, format) layout element"},
+    {"decode_batch", (PyCFunction)(void(*)(void))decode_batch, METH_VARARGS | METH_KEYWORDS,
+     "decode_batch(jobs, threads=0) -> list of decode_vertices results for (data, layout[, count[, out]]) jobs, "
+     "decoded on worker threads with the GIL released"},
+    {"build_vertex_buffer", (PyCFunction)(void(*)(void))build_vertex_buffer, METH_VARARGS | METH_KEYWORDS,
+     "build_vertex_buffer(positions, normals=None, uvs=None, colors=None, out=None) -> bytearray laid out as VBO_LAYOUT; "
+     "each stream is a buffer or (buffer, offset, stride)"},
+    {"compute_bounds", (PyCFunction)(void(*)(void))compute_bounds, METH_VARARGS | METH_KEYWORDS,
+     "compute_bounds(positions, threads=0) -> ((min x, y, z), (max x, y, z)) of float3 positions, or None when empty"},
+    {"compute_bounding_sphere", (PyCFunction)(void(*)(void))compute_bounding_sphere, METH_VARARGS | METH_KEYWORDS,
+     "compute_bounding_sphere(positions, threads=0) -> ((center x, y, z), radius) around the AABB center, or None when empty"},
+    {"compute_normals", (PyCFunction)(void(*)(void))compute_normals, METH_VARARGS | METH_KEYWORDS,
+     "compute_normals(positions, indices, index_size=2, threads=0, out=None) -> array('f') of area-weighted smooth normals"},
+    {"compute_tangents", (PyCFunction)(void(*)(void))compute_tangents, METH_VARARGS | METH_KEYWORDS,
+     "compute_tangents(positions, uvs, indices, normals=None, index_size=2, threads=0, out=None) -> array('f') of xyzw tangents, w the bitangent sign"},
+    {"stats", (PyCFunction)(void(*)(void))stats_get, METH_VARARGS | METH_KEYWORDS,
+     "stats(per_thread=False) -> {name: value} phase timers (*_ns) and counters collected while enabled; per_thread gives one value per worker slot"},
+    {"reset_stats", (PyCFunction)stats_reset, METH_NOARGS,
+     "reset_stats() -> None, zeroes the stats() timers and counters"},
+    {"enable_stats", (PyCFunction)(void(*)(void))stats_enable, METH_VARARGS | METH_KEYWORDS,
+     "enable_stats(enabled=True) -> previous state; REASY_NATIVE_STATS=1 enables collection at import"},
     {NULL, NULL, 0, NULL},
 };
 
@@ -237,5 +2184,28 @@ static struct PyModuleDef moduledef = {
 };
 
 PyMODINIT_FUNC PyInit_fastmesh(void) {
-    return PyModule_Create(&moduledef);
+    native_stats_init(&stats);
+    init_half_table();
+    if (!array_type) {
+        PyObject* array_mod = PyImport_ImportModule("array");
+        if (!array_mod) return NULL;
+        array_type = PyObject_GetAttrString(array_mod, "array");
+        Py_DECREF(array_mod);
+        if (!array_type) return NULL;
+    }
+    PyObject* module = PyModule_Create(&moduledef);
+    if (!module) return NULL;
+    PyObject* layout = PyTuple_New(VBO_STREAMS);
+    if (!layout || PyModule_AddIntConstant(module, "VBO_STRIDE", VBO_STRIDE) < 0) {
+        Py_XDECREF(layout); Py_DECREF(module); return NULL;
+    }
+    for (int k = 0; k < VBO_STREAMS; ++k) {
+        PyObject* entry = Py_BuildValue("(snis)", vbo_layout[k].name, vbo_layout[k].offset, vbo_layout[k].components, vbo_layout[k].gl_type);
+        if (!entry) { Py_DECREF(layout); Py_DECREF(module); return NULL; }
+        PyTuple_SET_ITEM(layout, k, entry);
+    }
+    if (PyModule_AddObject(module, "VBO_LAYOUT", layout) < 0) {
+        Py_DECREF(layout); Py_DECREF(module); return NULL;
+    }
+    return module;
 }
@@ -0,0 +1,113 @@
+#ifndef REASY_NATIVE_CPU_H
+#define REASY_NATIVE_CPU_H
+
+/* Runtime CPU feature detection for the native modules. Kernels for optional
+ * instruction sets are compiled with NATIVE_TARGET so the extension keeps a
+ * baseline build and picks the best variant at call time. */
+
+#include <stdint.h>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define NATIVE_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+#if defined(__aarch64__) || defined(_M_ARM64)
+#define NATIVE_NEON 1
+#include <arm_neon.h>
+#endif
+
+#if defined(_MSC_VER) && !defined(NATIVE_X86)
+#include <intrin.h>
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define NATIVE_TARGET(isa) __attribute__((target(isa)))
+#else
+#define NATIVE_TARGET(isa)
+#endif
+
+#define NATIVE_CPU_SSE2   0x01
+#define NATIVE_CPU_SSE41  0x02
+#define NATIVE_CPU_SSE42  0x04
+#define NATIVE_CPU_AVX2   0x08
+#define NATIVE_CPU_F16C   0x10
+#define NATIVE_CPU_NEON   0x20
+
+#ifdef NATIVE_X86
+static inline void native_cpuid(int leaf, int sub, unsigned int regs[4]) {
+#if defined(_MSC_VER)
+	int r[4];
+	__cpuidex(r, leaf, sub);
+	regs[0] = (unsigned int)r[0]; regs[1] = (unsigned int)r[1];
+	regs[2] = (unsigned int)r[2]; regs[3] = (unsigned int)r[3];
+#else
+	__cpuid_count(leaf, sub, regs[0], regs[1], regs[2], regs[3]);
+#endif
+}
+
+static inline unsigned long long native_xgetbv(void) {
+#if defined(_MSC_VER)
+	return _xgetbv(0);
+#else
+	unsigned int lo, hi;
+	__asm__ volatile("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+	return ((unsigned long long)hi << 32) | lo;
+#endif
+}
+#endif
+
+static inline int native_cpu_detect(void) {
+	int features = 0;
+#ifdef NATIVE_X86
+	unsigned int regs[4];
+	native_cpuid(0, 0, regs);
+	unsigned int max_leaf = regs[0];
+	native_cpuid(1, 0, regs);
+	if (regs[3] & (1U << 26)) features |= NATIVE_CPU_SSE2;
+	if (regs[2] & (1U << 19)) features |= NATIVE_CPU_SSE41;
+	if (regs[2] & (1U << 20)) features |= NATIVE_CPU_SSE42;
+	/* AVX-class state must also be enabled by the OS (OSXSAVE + XCR0 YMM bits). */
+	int ymm = (regs[2] & (1U << 27)) && (regs[2] & (1U << 28)) && (native_xgetbv() & 6) == 6;
+	if (ymm && (regs[2] & (1U << 29))) features |= NATIVE_CPU_F16C;
+	if (ymm && max_leaf >= 7) {
+		native_cpuid(7, 0, regs);
+		if (regs[1] & (1U << 5)) features |= NATIVE_CPU_AVX2;
+	}
+#endif
+#ifdef NATIVE_NEON
+	features |= NATIVE_CPU_NEON;
+#endif
+	return features;
+}
+
+/* Index of the lowest set bit; value must be nonzero. */
+static inline int native_ctz32(uint32_t value) {
+#if defined(_MSC_VER)
+	unsigned long index;
+	_BitScanForward(&index, value);
+	return (int)index;
+#else
+	return __builtin_ctz(value);
+#endif
+}
+
+/* Build-time cap on the dispatched kernels (setup.py REASY_NATIVE_ISA); NEON stays
+ * available because aarch64 has no scalar-only configuration worth testing. */
+#ifndef NATIVE_CPU_MASK
+#define NATIVE_CPU_MASK 0x3F
+#endif
+
+/* Cached feature mask; the first call may race benignly from several threads. */
+static inline int native_cpu_features(void) {
+	static int cached = -1;
+	if (cached < 0) cached = native_cpu_detect() & (NATIVE_CPU_MASK | NATIVE_CPU_NEON);
+	return cached;
+}
+
+#endif
@@ -0,0 +1,226 @@
+#ifndef REASY_NATIVE_FILE_H
+#define REASY_NATIVE_FILE_H
+
+/* Read-only file mapping and binary file opening for the native modules. Both take
+ * any os.PathLike/str path and raise OSError with the filename on failure. */
+
+#include <Python.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <io.h>
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+typedef struct {
+	const uint8_t* data;
+	Py_ssize_t size;
+#ifdef _WIN32
+	HANDLE mapping;
+#endif
+} native_mmap;
+
+static inline int native_mmap_open(native_mmap* m, PyObject* path) {
+	m->data = NULL; m->size = 0;
+#ifdef _WIN32
+	m->mapping = NULL;
+	PyObject* fspath = PyOS_FSPath(path);
+	if (!fspath) return -1;
+	if (!PyUnicode_Check(fspath)) {
+		PyObject* decoded = PyUnicode_DecodeFSDefaultAndSize(PyBytes_AS_STRING(fspath), PyBytes_GET_SIZE(fspath));
+		Py_DECREF(fspath);
+		if (!(fspath = decoded)) return -1;
+	}
+	wchar_t* wide = PyUnicode_AsWideCharString(fspath, NULL);
+	if (!wide) { Py_DECREF(fspath); return -1; }
+	HANDLE file = CreateFileW(wide, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+	PyMem_Free(wide);
+	LARGE_INTEGER size;
+	if (file == INVALID_HANDLE_VALUE || !GetFileSizeEx(file, &size)) {
+		PyErr_SetExcFromWindowsErrWithFilenameObject(PyExc_OSError, 0, fspath);
+		if (file != INVALID_HANDLE_VALUE) CloseHandle(file);
+		Py_DECREF(fspath); return -1;
+	}
+	if (size.QuadPart > 0) {
+		m->mapping = CreateFileMappingW(file, NULL, PAGE_READONLY, 0, 0, NULL);
+		m->data = m->mapping ? (const uint8_t*)MapViewOfFile(m->mapping, FILE_MAP_READ, 0, 0, 0) : NULL;
+		if (!m->data) {
+			PyErr_SetExcFromWindowsErrWithFilenameObject(PyExc_OSError, 0, fspath);
+			if (m->mapping) CloseHandle(m->mapping);
+			m->mapping = NULL; CloseHandle(file); Py_DECREF(fspath); return -1;
+		}
+	}
+	CloseHandle(file);
+	Py_DECREF(fspath);
+	m->size = (Py_ssize_t)size.QuadPart;
+#else
+	PyObject* encoded;
+	if (!PyUnicode_FSConverter(path, &encoded)) return -1;
+	int fd = open(PyBytes_AS_STRING(encoded), O_RDONLY);
+	struct stat st;
+	if (fd < 0 || fstat(fd, &st) != 0) {
+		PyErr_SetFromErrnoWithFilenameObject(PyExc_OSError, path);
+		if (fd >= 0) close(fd);
+		Py_DECREF(encoded); return -1;
+	}
+	if (st.st_size > 0) {
+		void* data = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+		if (data == MAP_FAILED) {
+			PyErr_SetFromErrnoWithFilenameObject(PyExc_OSError, path);
+			close(fd); Py_DECREF(encoded); return -1;
+		}
+		m->data = (const uint8_t*)data;
+	}
+	close(fd);
+	Py_DECREF(encoded);
+	m->size = (Py_ssize_t)st.st_size;
+#endif
+	return 0;
+}
+
+static inline void native_mmap_close(native_mmap* m) {
+	if (m->data) {
+#ifdef _WIN32
+		UnmapViewOfFile((LPCVOID)m->data);
+		CloseHandle(m->mapping);
+		m->mapping = NULL;
+#else
+		munmap((void*)m->data, (size_t)m->size);
+#endif
+	}
+	m->data = NULL; m->size = 0;
+}
+
+/* OS-native path string that worker threads can use without the GIL; free with PyMem_RawFree. */
+#ifdef _WIN32
+typedef wchar_t native_path_char;
+#else
+typedef char native_path_char;
+#endif
+
+static inline native_path_char* native_path_from_object(PyObject* path) {
+	native_path_char* out = NULL;
+#ifdef _WIN32
+	PyObject* fspath = PyOS_FSPath(path);
+	if (!fspath) return NULL;
+	if (!PyUnicode_Check(fspath)) {
+		PyObject* decoded = PyUnicode_DecodeFSDefaultAndSize(PyBytes_AS_STRING(fspath), PyBytes_GET_SIZE(fspath));
+		Py_DECREF(fspath);
+		if (!(fspath = decoded)) return NULL;
+	}
+	Py_ssize_t len;
+	wchar_t* wide = PyUnicode_AsWideCharString(fspath, &len);
+	Py_DECREF(fspath);
+	if (!wide) return NULL;
+	out = (native_path_char*)PyMem_RawMalloc((size_t)(len + 1) * sizeof(wchar_t));
+	if (out) memcpy(out, wide, (size_t)(len + 1) * sizeof(wchar_t));
+	PyMem_Free(wide);
+#else
+	PyObject* encoded;
+	if (!PyUnicode_FSConverter(path, &encoded)) return NULL;
+	size_t len = (size_t)PyBytes_GET_SIZE(encoded);
+	out = (native_path_char*)PyMem_RawMalloc(len + 1);
+	if (out) memcpy(out, PyBytes_AS_STRING(encoded), len + 1);
+	Py_DECREF(encoded);
+#endif
+	if (!out) PyErr_NoMemory();
+	return out;
+}
+
+/* GIL-free fopen(); mode is an ASCII stdio mode such as "wb". Sets errno on failure. */
+static inline FILE* native_fopen_path(const native_path_char* path, const char* mode) {
+#ifdef _WIN32
+	wchar_t wmode[8]; size_t i = 0;
+	for (; mode[i] && i < 7; ++i) wmode[i] = (wchar_t)mode[i];
+	wmode[i] = 0;
+	return _wfopen(path, wmode);
+#else
+	return fopen(path, mode);
+#endif
+}
+
+/* fopen() for a Python path object. */
+static inline FILE* native_fopen(PyObject* path, const char* mode) {
+	native_path_char* native = native_path_from_object(path);
+	if (!native) return NULL;
+	FILE* fp = native_fopen_path(native, mode);
+	PyMem_RawFree(native);
+	if (!fp) PyErr_SetFromErrnoWithFilenameObject(PyExc_OSError, path);
+	return fp;
+}
+
+/* 64-bit fseek(SEEK_SET) for writers that place data at computed offsets; returns 0 on success. */
+static inline int native_fseek(FILE* fp, unsigned long long offset) {
+#ifdef _WIN32
+	return _fseeki64(fp, (__int64)offset, SEEK_SET);
+#else
+	return fseeko(fp, (off_t)offset, SEEK_SET);
+#endif
+}
+
+/* Cuts the file to size, flushing pending writes first; returns 0 on success. */
+static inline int native_ftruncate(FILE* fp, unsigned long long size) {
+	if (fflush(fp) != 0) return -1;
+#ifdef _WIN32
+	return _chsize_s(_fileno(fp), (__int64)size) == 0 ? 0 : -1;
+#else
+	return ftruncate(fileno(fp), (off_t)size);
+#endif
+}
+
+/* Positional reads that several threads can issue against one file without sharing a cursor. */
+typedef struct {
+#ifdef _WIN32
+	HANDLE handle;
+#else
+	int fd;
+#endif
+} native_rfile;
+
+static inline int native_rfile_open(native_rfile* f, const native_path_char* path) {
+#ifdef _WIN32
+	f->handle = CreateFileW(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	return f->handle == INVALID_HANDLE_VALUE ? -1 : 0;
+#else
+	f->fd = open(path, O_RDONLY);
+	return f->fd < 0 ? -1 : 0;
+#endif
+}
+
+/* Reads exactly len bytes at offset; returns 0 on success. */
+static inline int native_pread(native_rfile* f, void* buf, size_t len, unsigned long long offset) {
+	uint8_t* out = (uint8_t*)buf;
+	while (len) {
+#ifdef _WIN32
+		OVERLAPPED ov;
+		DWORD chunk = len > 0x40000000 ? 0x40000000 : (DWORD)len, got = 0;
+		memset(&ov, 0, sizeof(ov));
+		ov.Offset = (DWORD)offset; ov.OffsetHigh = (DWORD)(offset >> 32);
+		if (!ReadFile(f->handle, out, chunk, &got, &ov) || got == 0) return -1;
+#else
+		ssize_t got = pread(f->fd, out, len > 0x40000000 ? 0x40000000 : len, (off_t)offset);
+		if (got <= 0) return -1;
+#endif
+		out += got; len -= (size_t)got; offset += (unsigned long long)got;
+	}
+	return 0;
+}
+
+static inline void native_rfile_close(native_rfile* f) {
+#ifdef _WIN32
+	if (f->handle != INVALID_HANDLE_VALUE) CloseHandle(f->handle);
+	f->handle = INVALID_HANDLE_VALUE;
+#else
+	if (f->fd >= 0) close(f->fd);
+	f->fd = -1;
+#endif
+}
+
+#endif
@@ -0,0 +1,148 @@
+#ifndef REASY_NATIVE_PARALLEL_H
+#define REASY_NATIVE_PARALLEL_H
+
+/* Minimal fork/join helper shared by the native modules. Workers must not touch
+ * the Python C API; callers release the GIL around native_parallel_for. */
+
+#include <Python.h>
+#include <stdlib.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+
+#define NATIVE_MAX_THREADS 64
+
+typedef void (*native_range_fn)(void* ctx, Py_ssize_t begin, Py_ssize_t end, int worker);
+
+typedef struct {
+	native_range_fn fn;
+	void* ctx;
+	Py_ssize_t begin;
+	Py_ssize_t end;
+	int worker;
+} native_task;
+
+static inline int native_cpu_count(void) {
+#ifdef _WIN32
+	SYSTEM_INFO info;
+	GetSystemInfo(&info);
+	return info.dwNumberOfProcessors > 0 ? (int)info.dwNumberOfProcessors : 1;
+#else
+	long count = sysconf(_SC_NPROCESSORS_ONLN);
+	return count > 0 ? (int)count : 1;
+#endif
+}
+
+/* Resolves a user-facing thread count: 0 means one per core. */
+static inline int native_thread_count(int requested) {
+	int threads = requested > 0 ? requested : native_cpu_count();
+	return threads > NATIVE_MAX_THREADS ? NATIVE_MAX_THREADS : threads;
+}
+
+/* Number of workers native_parallel_for will use for `count` items. */
+static inline int native_worker_count(Py_ssize_t count, int threads, Py_ssize_t min_chunk) {
+	if (min_chunk < 1) min_chunk = 1;
+	Py_ssize_t workers = (count + min_chunk - 1) / min_chunk;
+	if (workers > threads) workers = threads;
+	return workers < 1 ? 1 : (int)workers;
+}
+
+/* Returns the value before the add. */
+static inline long long native_atomic_add(volatile long long* target, long long value) {
+#ifdef _WIN32
+	return InterlockedExchangeAdd64((volatile LONG64*)target, value);
+#else
+	return __atomic_fetch_add(target, value, __ATOMIC_RELAXED);
+#endif
+}
+
+static inline long long native_atomic_load(volatile long long* target) {
+#ifdef _WIN32
+	return InterlockedCompareExchange64((volatile LONG64*)target, 0, 0);
+#else
+	return __atomic_load_n(target, __ATOMIC_RELAXED);
+#endif
+}
+
+static inline unsigned long long native_monotonic_ns(void) {
+#ifdef _WIN32
+	static LARGE_INTEGER frequency;
+	LARGE_INTEGER now;
+	if (!frequency.QuadPart) QueryPerformanceFrequency(&frequency);
+	QueryPerformanceCounter(&now);
+	return (unsigned long long)(now.QuadPart / frequency.QuadPart) * 1000000000ULL
+		+ (unsigned long long)(now.QuadPart % frequency.QuadPart) * 1000000000ULL / (unsigned long long)frequency.QuadPart;
+#else
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (unsigned long long)ts.tv_sec * 1000000000ULL + (unsigned long long)ts.tv_nsec;
+#endif
+}
+
+#ifdef _WIN32
+static inline DWORD WINAPI native_task_main(LPVOID arg) {
+	native_task* task = (native_task*)arg;
+	task->fn(task->ctx, task->begin, task->end, task->worker);
+	return 0;
+}
+#else
+static inline void* native_task_main(void* arg) {
+	native_task* task = (native_task*)arg;
+	task->fn(task->ctx, task->begin, task->end, task->worker);
+	return NULL;
+}
+#endif
+
+/* Splits [0, count) into contiguous chunks, one per worker, and runs fn on each.
+ * Chunk boundaries depend only on count and the worker count, so results written
+ * per item are deterministic. Worker 0 runs on the calling thread; if a thread
+ * cannot be started its chunk runs inline instead. */
+static inline void native_parallel_for(Py_ssize_t count, int threads, Py_ssize_t min_chunk, native_range_fn fn, void* ctx) {
+	int workers = native_worker_count(count, threads, min_chunk);
+	if (workers == 1) {
+		if (count > 0) fn(ctx, 0, count, 0);
+		return;
+	}
+
+	native_task tasks[NATIVE_MAX_THREADS];
+#ifdef _WIN32
+	HANDLE handles[NATIVE_MAX_THREADS];
+#else
+	pthread_t handles[NATIVE_MAX_THREADS];
+#endif
+	int started[NATIVE_MAX_THREADS];
+	for (int w = 0; w < workers; ++w) {
+		tasks[w].fn = fn;
+		tasks[w].ctx = ctx;
+		tasks[w].begin = (Py_ssize_t)((long long)count * w / workers);
+		tasks[w].end = (Py_ssize_t)((long long)count * (w + 1) / workers);
+		tasks[w].worker = w;
+		started[w] = 0;
+	}
+	for (int w = 1; w < workers; ++w) {
+#ifdef _WIN32
+		handles[w] = CreateThread(NULL, 0, native_task_main, &tasks[w], 0, NULL);
+		started[w] = handles[w] != NULL;
+#else
+		started[w] = pthread_create(&handles[w], NULL, native_task_main, &tasks[w]) == 0;
+#endif
+		if (!started[w]) native_task_main(&tasks[w]);
+	}
+	native_task_main(&tasks[0]);
+	for (int w = 1; w < workers; ++w) {
+		if (!started[w]) continue;
+#ifdef _WIN32
+		WaitForSingleObject(handles[w], INFINITE);
+		CloseHandle(handles[w]);
+#else
+		pthread_join(handles[w], NULL);
+#endif
+	}
+}
+
+#endif
@@ -0,0 +1,472 @@
+#ifndef REASY_NATIVE_SCAN_H
+#define REASY_NATIVE_SCAN_H
+
+/* Printable UTF-16LE / UTF-8 run detection shared by fast_string_scan and the fused resolver in
+ * fast_pakresolve. Everything here is GIL-free except scan_view, which releases the GIL itself. */
+
+#include <Python.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "native_cpu.h"
+#include "native_parallel.h"
+
+static inline int is_utf8_candidate_byte(uint8_t value) {
+	return (value >= 0x20 && value <= 0x7E) || value >= 0x80;
+}
+
+/* Strict UTF-8 validation matching PyUnicode_DecodeUTF8(..., "strict") plus a printable check on
+ * every code point; needs no GIL. Returns the largest code point, or 0 when the run is rejected. */
+static inline Py_UCS4 utf8_printable_maxchar(const uint8_t* data, Py_ssize_t length) {
+	Py_UCS4 maxchar = 0x7F;
+	Py_ssize_t i = 0;
+	while (i < length) {
+		uint8_t lead = data[i];
+		if (lead < 0x80) {
+			/* Candidate runs hold no control bytes, so ASCII is always printable here. */
+			i++;
+			continue;
+		}
+		Py_ssize_t need;
+		uint8_t low = 0x80, high = 0xBF;
+		Py_UCS4 codepoint;
+		if (lead >= 0xC2 && lead <= 0xDF) { need = 1; codepoint = lead & 0x1F; }
+		else if (lead >= 0xE0 && lead <= 0xEF) {
+			need = 2; codepoint = lead & 0x0F;
+			if (lead == 0xE0) low = 0xA0;
+			else if (lead == 0xED) high = 0x9F;
+		}
+		else if (lead >= 0xF0 && lead <= 0xF4) {
+			need = 3; codepoint = lead & 0x07;
+			if (lead == 0xF0) low = 0x90;
+			else if (lead == 0xF4) high = 0x8F;
+		}
+		else return 0;
+		if (length - i <= need) return 0;
+		for (Py_ssize_t k = 1; k <= need; ++k) {
+			uint8_t next = data[i + k];
+			if (next < (k == 1 ? low : 0x80) || next > (k == 1 ? high : 0xBF)) return 0;
+			codepoint = (codepoint << 6) | (next & 0x3F);
+		}
+		if (!Py_UNICODE_ISPRINTABLE(codepoint)) return 0;
+		if (codepoint > maxchar) maxchar = codepoint;
+		i += need + 1;
+	}
+	return maxchar;
+}
+
+/* Scanning works on 32-byte blocks. Each block is classified at once into two bit masks:
+ * `units` marks byte offsets that begin an ASCII-printable UTF-16LE code unit (32..126 followed
+ * by a zero byte), which covers both parities at once, and `bytes` marks UTF-8 candidate bytes.
+ * Three resumable streams (UTF-16 parity 0, parity 1, UTF-8) then walk the masks with bit scans,
+ * so only non-ASCII code units reach Py_UNICODE_ISPRINTABLE. */
+#define SCAN_BLOCK 32
+#define SCAN_UTF8 2
+
+typedef struct {
+	Py_ssize_t offset;
+	Py_ssize_t length;
+	Py_UCS4 maxchar;
+} scan_span;
+
+typedef struct {
+	scan_span* items;
+	Py_ssize_t count;
+	Py_ssize_t capacity;
+} span_list;
+
+typedef struct {
+	int in_run;
+	Py_ssize_t start;
+	Py_ssize_t pos;
+	Py_ssize_t stop;
+	Py_UCS4 maxchar;
+} scan_stream;
+
+typedef struct {
+	scan_stream streams[3];
+	Py_ssize_t min_length;
+	Py_ssize_t utf8_min_bytes;
+} scan_state;
+
+typedef void (*scan_mask_fn)(const uint8_t* block, uint32_t* units, uint32_t* bytes);
+
+static inline int span_push(span_list* list, Py_ssize_t offset, Py_ssize_t length, Py_UCS4 maxchar) {
+	if (list->count == list->capacity) {
+		Py_ssize_t capacity = list->capacity ? list->capacity * 2 : 256;
+		scan_span* items = (scan_span*)PyMem_RawRealloc(list->items, (size_t)capacity * sizeof(scan_span));
+		if (!items) return -1;
+		list->items = items;
+		list->capacity = capacity;
+	}
+	scan_span* span = &list->items[list->count++];
+	span->offset = offset;
+	span->length = length;
+	span->maxchar = maxchar;
+	return 0;
+}
+
+static inline void span_list_free(span_list* list) {
+	PyMem_RawFree(list->items);
+	list->items = NULL;
+	list->count = list->capacity = 0;
+}
+
+static inline void scan_state_init(scan_state* state, Py_ssize_t min_length) {
+	memset(state, 0, sizeof(*state));
+	state->streams[1].pos = 1;
+	for (int s = 0; s < 3; ++s) state->streams[s].stop = PY_SSIZE_T_MAX;
+	state->min_length = min_length;
+	state->utf8_min_bytes = min_length > 10 ? min_length : 10;
+}
+
+/* Classifies block[0..31]; avail is the number of readable bytes from block, possibly fewer than 33. */
+static inline void scan_masks_tail(const uint8_t* block, Py_ssize_t avail, uint32_t* units, uint32_t* bytes) {
+	uint32_t u = 0, b = 0;
+	for (int k = 0; k < SCAN_BLOCK && k < avail; ++k) {
+		if (is_utf8_candidate_byte(block[k])) b |= 1U << k;
+		if (k + 1 < avail && block[k] >= 32 && block[k] <= 126 && block[k + 1] == 0) u |= 1U << k;
+	}
+	*units = u;
+	*bytes = b;
+}
+
+static inline void scan_masks_scalar(const uint8_t* block, uint32_t* units, uint32_t* bytes) {
+	scan_masks_tail(block, SCAN_BLOCK + 1, units, bytes);
+}
+
+#ifdef NATIVE_X86
+NATIVE_TARGET("sse2") static inline void scan_masks_sse2(const uint8_t* block, uint32_t* units, uint32_t* bytes) {
+	const __m128i space = _mm_set1_epi8(0x20), span = _mm_set1_epi8(0x5E), del = _mm_set1_epi8(0x7F), zero = _mm_setzero_si128();
+	uint32_t u = 0, b = 0;
+	for (int half = 0; half < 2; ++half) {
+		__m128i lo = _mm_loadu_si128((const __m128i*)(block + half * 16));
+		__m128i hi = _mm_loadu_si128((const __m128i*)(block + half * 16 + 1));
+		__m128i shifted = _mm_sub_epi8(lo, space);
+		__m128i printable = _mm_cmpeq_epi8(_mm_min_epu8(shifted, span), shifted);
+		__m128i unit = _mm_and_si128(printable, _mm_cmpeq_epi8(hi, zero));
+		__m128i candidate = _mm_andnot_si128(_mm_cmpeq_epi8(lo, del), _mm_cmpeq_epi8(_mm_max_epu8(lo, space), lo));
+		u |= (uint32_t)_mm_movemask_epi8(unit) << (half * 16);
+		b |= (uint32_t)_mm_movemask_epi8(candidate) << (half * 16);
+	}
+	*units = u;
+	*bytes = b;
+}
+
+NATIVE_TARGET("avx2") static inline void scan_masks_avx2(const uint8_t* block, uint32_t* units, uint32_t* bytes) {
+	const __m256i space = _mm256_set1_epi8(0x20), span = _mm256_set1_epi8(0x5E), del = _mm256_set1_epi8(0x7F), zero = _mm256_setzero_si256();
+	__m256i lo = _mm256_loadu_si256((const __m256i*)block);
+	__m256i hi = _mm256_loadu_si256((const __m256i*)(block + 1));
+	__m256i shifted = _mm256_sub_epi8(lo, space);
+	__m256i printable = _mm256_cmpeq_epi8(_mm256_min_epu8(shifted, span), shifted);
+	__m256i unit = _mm256_and_si256(printable, _mm256_cmpeq_epi8(hi, zero));
+	__m256i candidate = _mm256_andnot_si256(_mm256_cmpeq_epi8(lo, del), _mm256_cmpeq_epi8(_mm256_max_epu8(lo, space), lo));
+	*units = (uint32_t)_mm256_movemask_epi8(unit);
+	*bytes = (uint32_t)_mm256_movemask_epi8(candidate);
+}
+#endif
+
+#ifdef NATIVE_NEON
+static inline uint32_t neon_movemask(uint8x16_t mask) {
+	static const uint8_t weights[16] = {1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128};
+	uint8x16_t bits = vandq_u8(mask, vld1q_u8(weights));
+	return (uint32_t)vaddv_u8(vget_low_u8(bits)) | ((uint32_t)vaddv_u8(vget_high_u8(bits)) << 8);
+}
+
+static inline void scan_masks_neon(const uint8_t* block, uint32_t* units, uint32_t* bytes) {
+	const uint8x16_t space = vdupq_n_u8(0x20), span = vdupq_n_u8(0x5E), del = vdupq_n_u8(0x7F), zero = vdupq_n_u8(0);
+	uint32_t u = 0, b = 0;
+	for (int half = 0; half < 2; ++half) {
+		uint8x16_t lo = vld1q_u8(block + half * 16);
+		uint8x16_t hi = vld1q_u8(block + half * 16 + 1);
+		uint8x16_t unit = vandq_u8(vcleq_u8(vsubq_u8(lo, space), span), vceqq_u8(hi, zero));
+		uint8x16_t candidate = vandq_u8(vcgeq_u8(lo, space), vmvnq_u8(vceqq_u8(lo, del)));
+		u |= neon_movemask(unit) << (half * 16);
+		b |= neon_movemask(candidate) << (half * 16);
+	}
+	*units = u;
+	*bytes = b;
+}
+#endif
+
+static inline scan_mask_fn scan_select_masks(void) {
+#ifdef NATIVE_X86
+	int features = native_cpu_features();
+	if (features & NATIVE_CPU_AVX2) return scan_masks_avx2;
+	if (features & NATIVE_CPU_SSE2) return scan_masks_sse2;
+#endif
+#ifdef NATIVE_NEON
+	return scan_masks_neon;
+#endif
+	return scan_masks_scalar;
+}
+
+/* Advances one UTF-16 stream through the block at absolute offset block_start. A run starts at an
+ * ASCII-printable unit and ends at the first zero or non-printable unit; a short run can never be
+ * followed by a longer one inside the same printable segment, so both cases resume after the
+ * terminating unit. Without `final`, a stream stops at the first unit that is not fully buffered. */
+static inline int scan_utf16_block(scan_state* state, int parity, const uint8_t* data, Py_ssize_t base, Py_ssize_t end, int final,
+	Py_ssize_t block_start, uint32_t units, span_list* out) {
+	scan_stream* stream = &state->streams[parity];
+	if (stream->pos < block_start) return 0;
+	uint32_t lane = ((block_start ^ parity) & 1) ? 0xAAAAAAAAU : 0x55555555U;
+	Py_ssize_t next_block = block_start + SCAN_BLOCK + ((block_start ^ parity) & 1);
+	Py_ssize_t first_partial = ((end - 1 - parity) & 1) ? end : end - 1;
+	while (stream->pos < block_start + SCAN_BLOCK) {
+		uint32_t from = lane & (0xFFFFFFFFU << (stream->pos - block_start));
+		if (!stream->in_run) {
+			uint32_t starts = units & from;
+			if (!starts) {
+				stream->pos = !final && first_partial < next_block ? first_partial : next_block;
+				break;
+			}
+			stream->start = block_start + native_ctz32(starts);
+			if (stream->start >= stream->stop) {
+				stream->pos = PY_SSIZE_T_MAX;
+				break;
+			}
+			stream->pos = stream->start + 2;
+			stream->maxchar = 0;
+			stream->in_run = 1;
+			continue;
+		}
+		uint32_t stops = ~units & from;
+		if (!stops) {
+			stream->pos = next_block;
+			break;
+		}
+		Py_ssize_t at = block_start + native_ctz32(stops);
+		if (at + 1 < end) {
+			Py_UCS4 codepoint = (Py_UCS4)data[at - base] | ((Py_UCS4)data[at - base + 1] << 8);
+			if (codepoint != 0 && Py_UNICODE_ISPRINTABLE(codepoint)) {
+				if (codepoint > stream->maxchar) stream->maxchar = codepoint;
+				stream->pos = at + 2;
+				continue;
+			}
+		} else if (!final) {
+			stream->pos = at;
+			return 0;
+		}
+		if ((at - stream->start) / 2 >= state->min_length && span_push(out, stream->start, at - stream->start, stream->maxchar) != 0) return -1;
+		stream->in_run = 0;
+		stream->pos = at + 2;
+	}
+	return 0;
+}
+
+/* UTF-8 spans are maximal runs of candidate bytes that decode strictly to printable text. */
+static inline int scan_utf8_block(scan_state* state, const uint8_t* data, Py_ssize_t base, Py_ssize_t end, int final,
+	Py_ssize_t block_start, uint32_t bytes, span_list* out) {
+	scan_stream* stream = &state->streams[SCAN_UTF8];
+	if (stream->pos < block_start) return 0;
+	while (stream->pos < block_start + SCAN_BLOCK) {
+		uint32_t from = 0xFFFFFFFFU << (stream->pos - block_start);
+		if (!stream->in_run) {
+			uint32_t starts = bytes & from;
+			if (!starts) {
+				stream->pos = !final && end < block_start + SCAN_BLOCK ? end : block_start + SCAN_BLOCK;
+				break;
+			}
+			stream->start = block_start + native_ctz32(starts);
+			if (stream->start >= stream->stop) {
+				stream->pos = PY_SSIZE_T_MAX;
+				break;
+			}
+			stream->pos = stream->start + 1;
+			stream->in_run = 1;
+			continue;
+		}
+		uint32_t stops = ~bytes & from;
+		if (!stops) {
+			stream->pos = block_start + SCAN_BLOCK;
+			break;
+		}
+		Py_ssize_t at = block_start + native_ctz32(stops);
+		if (at >= end && !final) {
+			stream->pos = at;
+			return 0;
+		}
+		if (at - stream->start >= state->utf8_min_bytes) {
+			Py_UCS4 maxchar = utf8_printable_maxchar(data + (stream->start - base), at - stream->start);
+			if (maxchar && span_push(out, stream->start, at - stream->start, maxchar) != 0) return -1;
+		}
+		stream->in_run = 0;
+		stream->pos = at + 1;
+	}
+	return 0;
+}
+
+/* True once every stream has passed its stop offset outside a run. */
+static inline int scan_streams_done(const scan_state* state) {
+	for (int s = 0; s < 3; ++s) {
+		if (state->streams[s].in_run || state->streams[s].pos < state->streams[s].stop) return 0;
+	}
+	return 1;
+}
+
+/* Scans data[0..length), which holds absolute offsets [base, base + length), appending finished
+ * spans to out[stream]. With final == 0, runs touching the end stay open in state for the next call;
+ * the caller must keep every byte from scan_state_keep() onwards. Needs no GIL. */
+static inline int scan_advance(scan_state* state, scan_mask_fn masks, const uint8_t* data, Py_ssize_t base, Py_ssize_t length, int final, span_list out[3]) {
+	Py_ssize_t end = base + length;
+	Py_ssize_t block_start = state->streams[0].pos;
+	for (int s = 1; s < 3; ++s) if (state->streams[s].pos < block_start) block_start = state->streams[s].pos;
+	Py_ssize_t limit = final ? end + 1 : end;
+	for (; block_start < limit; block_start += SCAN_BLOCK) {
+		uint32_t units, bytes;
+		Py_ssize_t rel = block_start - base;
+		if (rel + SCAN_BLOCK + 1 <= length) masks(data + rel, &units, &bytes);
+		else scan_masks_tail(data + rel, length - rel, &units, &bytes);
+		if (scan_utf16_block(state, 0, data, base, end, final, block_start, units, &out[0]) != 0
+			|| scan_utf16_block(state, 1, data, base, end, final, block_start, units, &out[1]) != 0
+			|| scan_utf8_block(state, data, base, end, final, block_start, bytes, &out[SCAN_UTF8]) != 0) {
+			return -1;
+		}
+		if (scan_streams_done(state)) break;
+	}
+	return 0;
+}
+
+/* Multi-needle filter over the UTF-8 encoding of a span's characters (UTF-16 units are re-encoded
+ * on the fly). Substring filters are an Aho-Corasick automaton flattened into a DFA; prefix filters
+ * keep the bare trie and reject as soon as a byte leaves it. `next` holds 256 entries per node. */
+typedef struct {
+	int32_t* next;
+	uint8_t* terminal;
+	Py_ssize_t nodes;
+	int prefix;
+	int ignore_case;
+} string_filter;
+
+static inline int string_filter_step(const string_filter* filter, int32_t* state, uint8_t byte) {
+	if (filter->ignore_case && byte >= 'A' && byte <= 'Z') byte = (uint8_t)(byte + 32);
+	*state = filter->next[(Py_ssize_t)*state * 256 + byte];
+	return *state >= 0 && filter->terminal[*state];
+}
+
+/* 1 if the span contains a needle (or starts with one in prefix mode). */
+static inline int string_filter_match(const string_filter* filter, const uint8_t* data, Py_ssize_t length, int utf8) {
+	int32_t state = 0;
+	if (filter->terminal[0]) return 1;
+	if (utf8) {
+		for (Py_ssize_t i = 0; i < length && state >= 0; ++i) {
+			if (string_filter_step(filter, &state, data[i])) return 1;
+		}
+		return 0;
+	}
+	for (Py_ssize_t i = 0; i + 1 < length && state >= 0; i += 2) {
+		unsigned int unit = (unsigned int)data[i] | ((unsigned int)data[i + 1] << 8);
+		uint8_t encoded[3]; int n;
+		if (unit < 0x80) { encoded[0] = (uint8_t)unit; n = 1; }
+		else if (unit < 0x800) { encoded[0] = (uint8_t)(0xC0 | (unit >> 6)); encoded[1] = (uint8_t)(0x80 | (unit & 0x3F)); n = 2; }
+		else { encoded[0] = (uint8_t)(0xE0 | (unit >> 12)); encoded[1] = (uint8_t)(0x80 | ((unit >> 6) & 0x3F)); encoded[2] = (uint8_t)(0x80 | (unit & 0x3F)); n = 3; }
+		for (int k = 0; k < n && state >= 0; ++k) {
+			if (string_filter_step(filter, &state, encoded[k])) return 1;
+		}
+	}
+	return 0;
+}
+
+/* Drops, in place, spans that the filter rejects. */
+static inline void spans_filter(span_list* list, const string_filter* filter, const uint8_t* data, Py_ssize_t base, int utf8) {
+	Py_ssize_t kept = 0;
+	for (Py_ssize_t i = 0; i < list->count; ++i) {
+		const scan_span* span = &list->items[i];
+		if (string_filter_match(filter, data + (span->offset - base), span->length, utf8)) list->items[kept++] = *span;
+	}
+	list->count = kept;
+}
+
+#define SCAN_MIN_CHUNK (1 << 20)
+
+/* Parallel scans split the input at chunk boundaries and resynchronize each stream just past
+ * the first terminating unit or byte at the boundary: every stream is searching there no matter
+ * what came before, so a worker emits the spans starting before the next worker's sync offset.
+ * Runs crossing a boundary are finished by the worker that started them. */
+typedef struct {
+	const uint8_t* data;
+	Py_ssize_t length;
+	Py_ssize_t min_length;
+	scan_mask_fn masks;
+	const string_filter* filter;
+	span_list spans[NATIVE_MAX_THREADS][3];
+	int workers;
+	int failed;
+} scan_job;
+
+static inline Py_ssize_t scan_sync_offset(const uint8_t* data, Py_ssize_t length, int stream, Py_ssize_t boundary) {
+	if (stream == SCAN_UTF8) {
+		Py_ssize_t at = boundary - 1;
+		while (at < length && is_utf8_candidate_byte(data[at])) at++;
+		return at + 1;
+	}
+	Py_ssize_t at = boundary - 2;
+	if ((at ^ stream) & 1) at++;
+	while (at + 1 < length) {
+		Py_UCS4 codepoint = (Py_UCS4)data[at] | ((Py_UCS4)data[at + 1] << 8);
+		if (codepoint == 0 || !Py_UNICODE_ISPRINTABLE(codepoint)) break;
+		at += 2;
+	}
+	return at + 2;
+}
+
+static inline void scan_range(void* ctx, Py_ssize_t begin, Py_ssize_t end, int worker) {
+	scan_job* job = (scan_job*)ctx;
+	scan_state state;
+	scan_state_init(&state, job->min_length);
+	for (int s = 0; s < 3; ++s) {
+		if (begin > 0) state.streams[s].pos = scan_sync_offset(job->data, job->length, s, begin);
+		if (end < job->length) state.streams[s].stop = scan_sync_offset(job->data, job->length, s, end);
+	}
+	if (scan_advance(&state, job->masks, job->data, 0, job->length, 1, job->spans[worker]) != 0) {
+		job->failed = 1;
+		return;
+	}
+	if (job->filter) {
+		for (int s = 0; s < 3; ++s) spans_filter(&job->spans[worker][s], job->filter, job->data, 0, s == SCAN_UTF8);
+	}
+}
+
+static inline void scan_job_free(scan_job* job) {
+	for (int w = 0; w < job->workers; ++w) {
+		for (int s = 0; s < 3; ++s) span_list_free(&job->spans[w][s]);
+	}
+	PyMem_Free(job);
+}
+
+/* Runs the parallel scan over view with the GIL released; per-worker spans are in offset order. */
+static inline scan_job* scan_view(const Py_buffer* view, Py_ssize_t min_length, int threads, const string_filter* filter) {
+	scan_job* job = (scan_job*)PyMem_Calloc(1, sizeof(scan_job));
+	if (!job) {
+		PyErr_NoMemory();
+		return NULL;
+	}
+	job->data = (const uint8_t*)view->buf;
+	job->length = view->len;
+	job->min_length = min_length;
+	job->masks = scan_select_masks();
+	job->filter = filter;
+	job->workers = native_worker_count(view->len, native_thread_count(threads), SCAN_MIN_CHUNK);
+	Py_BEGIN_ALLOW_THREADS
+	native_parallel_for(view->len ? view->len : 1, job->workers, SCAN_MIN_CHUNK, scan_range, job);
+	Py_END_ALLOW_THREADS
+	if (job->failed) {
+		scan_job_free(job);
+		PyErr_NoMemory();
+		return NULL;
+	}
+	return job;
+}
+
+/* Earliest absolute offset a later scan_advance() call can still read. */
+static inline Py_ssize_t scan_state_keep(const scan_state* state) {
+	Py_ssize_t keep = PY_SSIZE_T_MAX;
+	for (int s = 0; s < 3; ++s) {
+		const scan_stream* stream = &state->streams[s];
+		Py_ssize_t from = stream->in_run ? stream->start : stream->pos;
+		if (from < keep) keep = from;
+	}
+	return keep;
+}
+
+#endif
@@ -0,0 +1,120 @@
+#ifndef REASY_NATIVE_STATS_H
+#define REASY_NATIVE_STATS_H
+
+/* Opt-in phase timers and counters for the native modules. Each module owns one
+ * native_stats with its own counter names; names ending in "_ns" are timers.
+ * While disabled a hook costs one relaxed load. Kernels add into the slot of
+ * their worker index, so parallel workers keep to their own cache lines, and
+ * stats() sums the slots. */
+
+#include <Python.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "native_parallel.h"
+
+#define NATIVE_STATS_MAX 32
+
+/* 256 bytes, so one worker's counters never share a cache line with the next. */
+typedef struct {
+	volatile long long values[NATIVE_STATS_MAX];
+} native_stats_slot;
+
+typedef struct {
+	native_stats_slot slots[NATIVE_MAX_THREADS];
+	volatile long long enabled;
+	int count;
+	const char* const* names;
+} native_stats;
+
+#define NATIVE_STATS_INIT(names) {{{{0}}}, 0, (int)(sizeof(names) / sizeof((names)[0])), (names)}
+
+static inline int native_stats_on(native_stats* s) {
+	return native_atomic_load(&s->enabled) != 0;
+}
+
+static inline void native_stats_add(native_stats* s, int worker, int counter, long long value) {
+	if (native_stats_on(s)) native_atomic_add(&s->slots[worker % NATIVE_MAX_THREADS].values[counter], value);
+}
+
+/* Start of a timed phase; 0 while disabled, which native_stats_time ignores. */
+static inline unsigned long long native_stats_clock(native_stats* s) {
+	return native_stats_on(s) ? native_monotonic_ns() : 0ULL;
+}
+
+static inline void native_stats_time(native_stats* s, int worker, int counter, unsigned long long start) {
+	if (start) native_atomic_add(&s->slots[worker % NATIVE_MAX_THREADS].values[counter], (long long)(native_monotonic_ns() - start));
+}
+
+/* REASY_NATIVE_STATS=1 enables collection from import time, e.g. for production logs. */
+static inline void native_stats_init(native_stats* s) {
+	const char* env = getenv("REASY_NATIVE_STATS");
+	s->enabled = env && env[0] && strcmp(env, "0") != 0;
+}
+
+/* {name: total}, or {name: [per-slot values]} trimmed after the last slot in use. */
+static inline PyObject* native_stats_dict(native_stats* s, int per_thread) {
+	int used = 1;
+	for (int w = 0; w < NATIVE_MAX_THREADS; ++w) {
+		for (int c = 0; c < s->count; ++c) {
+			if (native_atomic_load(&s->slots[w].values[c])) used = w + 1;
+		}
+	}
+	PyObject* result = PyDict_New();
+	if (!result) return NULL;
+	for (int c = 0; c < s->count; ++c) {
+		PyObject* value;
+		if (per_thread) {
+			value = PyList_New(used);
+			for (int w = 0; value && w < used; ++w) {
+				PyObject* item = PyLong_FromLongLong(native_atomic_load(&s->slots[w].values[c]));
+				if (!item) { Py_CLEAR(value); break; }
+				PyList_SET_ITEM(value, w, item);
+			}
+		} else {
+			long long total = 0;
+			for (int w = 0; w < NATIVE_MAX_THREADS; ++w) total += native_atomic_load(&s->slots[w].values[c]);
+			value = PyLong_FromLongLong(total);
+		}
+		if (!value || PyDict_SetItemString(result, s->names[c], value) < 0) {
+			Py_XDECREF(value);
+			Py_DECREF(result);
+			return NULL;
+		}
+		Py_DECREF(value);
+	}
+	return result;
+}
+
+/* Zeroes every slot; concurrent kernels may land a last add either side of it. */
+static inline void native_stats_reset(native_stats* s) {
+	for (int w = 0; w < NATIVE_MAX_THREADS; ++w) {
+		for (int c = 0; c < s->count; ++c) {
+			long long value = native_atomic_load(&s->slots[w].values[c]);
+			if (value) native_atomic_add(&s->slots[w].values[c], -value);
+		}
+	}
+}
+
+/* Bodies of the module-level stats(per_thread=False) and enable_stats(enabled=True). */
+static inline PyObject* native_stats_get_method(native_stats* s, PyObject* args, PyObject* kwargs) {
+	static char* kwlist[] = {"per_thread", NULL};
+	int per_thread = 0;
+	if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|p", kwlist, &per_thread)) return NULL;
+	return native_stats_dict(s, per_thread);
+}
+
+static inline PyObject* native_stats_enable_method(native_stats* s, PyObject* args, PyObject* kwargs) {
+	static char* kwlist[] = {"enabled", NULL};
+	int enabled = 1;
+	if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|p", kwlist, &enabled)) return NULL;
+	int previous = native_stats_on(s);
+#ifdef _WIN32
+	InterlockedExchange64((volatile LONG64*)&s->enabled, enabled);
+#else
+	__atomic_store_n(&s->enabled, (long long)enabled, __ATOMIC_RELAXED);
+#endif
+	return PyBool_FromLong(previous);
+}
+
+#endif
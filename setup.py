@@ -1,8 +1,59 @@
+import glob
 import os
+import sysconfig
 from setuptools import setup, Extension
 
+# Optional build variants, selected through the environment so the same command
+# works from prepare_env, utils.native_build and benchmarks/pgo_build.py:
+#   REASY_NATIVE_LTO=1               link-time optimization
+#   REASY_NATIVE_PGO=generate|use    instrumented / profile-optimized build
+#   REASY_NATIVE_PGO_DIR=path        where profiles are written and read (default build/pgo)
+#   REASY_NATIVE_ISA=scalar|sse2|sse41|avx2
+#                                    cap the SIMD kernels picked at run time, e.g. to
+#                                    profile or test the fallback paths on a newer CPU
+# SIMD kernels are always compiled per instruction set and chosen by CPUID at run
+# time (native_cpu.h), so no variant needs -march and every build runs anywhere.
+ISA_MASKS = {'scalar': 0x00, 'sse2': 0x01, 'sse41': 0x03, 'avx2': 0x1F}
+
+msvc = os.name == 'nt'
+clang = 'clang' in (sysconfig.get_config_var('CC') or '')
+compile_args = ['/O2'] if msvc else ['-O3']
+link_args = []
+macros = []
+
+if os.environ.get('REASY_NATIVE_LTO') == '1':
+    compile_args += ['/GL'] if msvc else ['-flto']
+    link_args += ['/LTCG'] if msvc else ['-flto']
+
+pgo = os.environ.get('REASY_NATIVE_PGO', '')
+if pgo not in ('', 'generate', 'use'):
+    raise SystemExit(f'REASY_NATIVE_PGO must be generate or use, not {pgo!r}')
+pgo_dir = os.path.abspath(os.environ.get('REASY_NATIVE_PGO_DIR', os.path.join('build', 'pgo')))
+if pgo == 'generate':
+    if msvc:
+        compile_args += ['/GL']
+        link_args += ['/LTCG', f'/GENPROFILE:PGD={pgo_dir}\\reasy.pgd']
+    else:
+        compile_args += [f'-fprofile-generate={pgo_dir}']
+        link_args += [f'-fprofile-generate={pgo_dir}']
+elif pgo == 'use':
+    if msvc:
+        compile_args += ['/GL']
+        link_args += ['/LTCG', f'/USEPROFILE:PGD={pgo_dir}\\reasy.pgd']
+    elif clang:
+        # clang reads the merged profile written by llvm-profdata (see benchmarks/pgo_build.py)
+        compile_args += [f'-fprofile-use={os.path.join(pgo_dir, "default.profdata")}', '-Wno-profile-instr-unprofiled']
+    else:
+        # -fprofile-correction absorbs counter races from the threaded kernels; a module
+        # without profile data still warns (-Wmissing-profile) so a mismatch is visible
+        compile_args += [f'-fprofile-use={pgo_dir}', '-fprofile-correction']
+
+isa = os.environ.get('REASY_NATIVE_ISA', '')
+if isa:
+    if isa not in ISA_MASKS:
+        raise SystemExit(f'REASY_NATIVE_ISA must be one of {", ".join(ISA_MASKS)}, not {isa!r}')
+    macros.append(('NATIVE_CPU_MASK', hex(ISA_MASKS[isa])))
 
-compile_args = ['/O2'] if os.name == 'nt' else ['-O3']
 ext_modules = []
 for module_name in ('fast_pakresolve', 'fast_string_scan', 'fastmesh'):
     source_path = f'native/{module_name}.c'
@@ -11,7 +62,10 @@ for module_name in ('fast_pakresolve', 'fast_string_scan', 'fastmesh'):
             Extension(
                 module_name,
                 sources=[source_path],
+                depends=glob.glob('native/*.h'),
+                define_macros=macros,
                 extra_compile_args=compile_args,
+                extra_link_args=link_args,
             )
         )
 